@@ -0,0 +1,348 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "archive.h"
+
+#define BLOCK_SIZE 512
+// tar pads archives to a multiple of 20 blocks
+#define RECORD_SIZE (BLOCK_SIZE * 20)
+
+typedef struct __attribute__((__packed__))
+{
+    char name[100];
+    char mode[8];
+    char uid[8];
+    char gid[8];
+    char size[12];
+    char mtime[12];
+    char checksum[8];
+    char type;
+    char linkName[100];
+    char magic[6];
+    char version[2];
+    char userName[32];
+    char groupName[32];
+    char devMajor[8];
+    char devMinor[8];
+    char prefix[155];
+    char pad[12];
+} USTAR_HEADER;
+
+static const char zeros[RECORD_SIZE];
+
+/* Writes all iovecs, continuing after short writes */
+static bool writeAll(int fd, struct iovec *iov, int count)
+{
+    while(count)
+    {
+        ssize_t written = writev(fd, iov, count);
+        if(written == -1)
+        {
+            if(errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        for(; count && (size_t)written >= iov->iov_len; iov++, count--)
+            written -= iov->iov_len;
+
+        if(count)
+        {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Reads exactly size bytes, continuing after short reads. data may be NULL to skip them. errno is 0 at an early EOF
+ *
+ * Skipped bytes go to the stack, so readers of different archives can run at the same time.
+ */
+static bool readAll(int fd, void *data, size_t size)
+{
+    char scratch[RECORD_SIZE];
+    while(size)
+    {
+        void *to = data != NULL ? data : scratch;
+        size_t n = data != NULL || size < sizeof(scratch) ? size : sizeof(scratch);
+        ssize_t r = read(fd, to, n);
+        if(r == -1 && errno == EINTR)
+            continue;
+
+        if(r <= 0)
+        {
+            if(r == 0)
+                errno = 0;
+
+            return false;
+        }
+
+        if(data != NULL)
+            data = (char *)data + r;
+
+        size -= r;
+    }
+
+    return true;
+}
+
+/* Writes to an already open fd (stdout for example), archiveClose() closes it */
+void archiveOpenFd(ARCHIVE *a, int fd)
+{
+    a->fd = fd;
+    a->size = 0;
+    a->mtime = time(NULL);
+    pthread_mutex_init(&a->lock, NULL);
+}
+
+/* Creates the archive file, an existing one gets overwritten */
+bool archiveOpen(ARCHIVE *a, const char *file)
+{
+    int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if(fd == -1)
+    {
+        fprintf(stderr, "Error opening %s: %s\n", file, strerror(errno));
+        return false;
+    }
+
+    archiveOpenFd(a, fd);
+    return true;
+}
+
+static bool addEntry(ARCHIVE *a, const char *path, char type, const void *data, size_t size)
+{
+    size_t pl = strlen(path);
+    if(pl > sizeof(((USTAR_HEADER *)NULL)->name))
+    {
+        fprintf(stderr, "Path too long for the archive: %s\n", path);
+        return false;
+    }
+
+    USTAR_HEADER hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.name, path, pl);
+    memcpy(hdr.mode, type == '5' ? "0000755" : "0000644", 8);
+    memcpy(hdr.uid, "0000000", 8);
+    memcpy(hdr.gid, "0000000", 8);
+    snprintf(hdr.size, sizeof(hdr.size), "%011zo", size);
+    snprintf(hdr.mtime, sizeof(hdr.mtime), "%011llo", (unsigned long long)a->mtime);
+    hdr.type = type;
+    memcpy(hdr.magic, "ustar", 6);
+    memcpy(hdr.version, "00", 2);
+
+    // The checksum is calculated with the checksum field set to spaces
+    memset(hdr.checksum, ' ', sizeof(hdr.checksum));
+    unsigned int sum = 0;
+    for(size_t i = 0; i < sizeof(hdr); i++)
+        sum += ((const uint8_t *)&hdr)[i];
+
+    snprintf(hdr.checksum, sizeof(hdr.checksum), "%06o", sum);
+
+    struct iovec iov[3] = {
+        { .iov_base = &hdr, .iov_len = sizeof(hdr) },
+        { .iov_base = (void *)data, .iov_len = size },
+        { .iov_base = (void *)zeros, .iov_len = (BLOCK_SIZE - size % BLOCK_SIZE) % BLOCK_SIZE },
+    };
+
+    pthread_mutex_lock(&a->lock);
+    bool ret = writeAll(a->fd, iov, 3);
+    if(ret)
+        a->size += sizeof(hdr) + size + iov[2].iov_len;
+
+    pthread_mutex_unlock(&a->lock);
+    if(!ret)
+        fprintf(stderr, "Error writing %s to the archive: %s\n", path, strerror(errno));
+
+    return ret;
+}
+
+/* Adds a directory entry, path has to end with a '/' */
+bool archiveAddDir(ARCHIVE *a, const char *path)
+{
+    return addEntry(a, path, '5', NULL, 0);
+}
+
+/* Adds a regular file, thread safe */
+bool archiveAdd(ARCHIVE *a, const char *path, const void *data, size_t size)
+{
+    return addEntry(a, path, '0', data, size);
+}
+
+/* Writes the end of archive marker and closes the archive */
+bool archiveClose(ARCHIVE *a)
+{
+    // Two empty blocks, then pad to a full record
+    size_t end = a->size + BLOCK_SIZE * 2;
+    end += (RECORD_SIZE - end % RECORD_SIZE) % RECORD_SIZE;
+
+    bool ret = true;
+    for(size_t left = end - a->size; ret && left; )
+    {
+        size_t n = left < sizeof(zeros) ? left : sizeof(zeros);
+        struct iovec iov = { .iov_base = (void *)zeros, .iov_len = n };
+        ret = writeAll(a->fd, &iov, 1);
+        left -= n;
+    }
+
+    if(close(a->fd) == -1)
+        ret = false;
+
+    if(!ret)
+        fprintf(stderr, "Error writing the archive: %s\n", strerror(errno));
+
+    pthread_mutex_destroy(&a->lock);
+    return ret;
+}
+
+void archiveReaderInit(ARCHIVE_READER *r, int fd)
+{
+    r->fd = fd;
+    r->longName[0] = '\0';
+}
+
+/* Parses a numeric header field: Octal, or base-256 if the high bit of the first byte is set (GNU) */
+static bool headerNumber(const char *field, size_t len, uint64_t *value)
+{
+    *value = 0;
+    if((uint8_t)field[0] & 0x80)
+    {
+        for(size_t i = 1; i < len; i++)
+            *value = (*value << 8) | (uint8_t)field[i];
+
+        return true;
+    }
+
+    size_t i = 0;
+    while(i < len && field[i] == ' ')
+        i++;
+
+    for(; i < len && field[i] >= '0' && field[i] <= '7'; i++)
+        *value = (*value << 3) | (field[i] - '0');
+
+    return i == len || field[i] == ' ' || field[i] == '\0';
+}
+
+/* Takes the path record ("LEN path=VALUE\n") out of pax extended header data, if there is one */
+static void paxPath(ARCHIVE_READER *r, const char *data, size_t size)
+{
+    size_t pos = 0;
+    while(pos < size)
+    {
+        char *end;
+        unsigned long len = strtoul(data + pos, &end, 10);
+        if(len == 0 || len > size - pos || *end != ' ')
+            return;
+
+        const char *last = data + pos + len - 1; // The '\n'
+        const char *value = end + 1 + 5;
+        if(*last == '\n' && value <= last && memcmp(end + 1, "path=", 5) == 0 && (size_t)(last - value) < sizeof(r->longName))
+        {
+            memcpy(r->longName, value, last - value);
+            r->longName[last - value] = '\0';
+        }
+
+        pos += len;
+    }
+}
+
+/*
+ * Reads the next regular file from the stream
+ *
+ * Its path (null terminated, truncated to pathSize) goes to path, its size to size and up to max bytes of its data
+ * to data, the rest gets skipped. Returns 1 for a file, 0 at the end of the archive and -1 on errors.
+ */
+int archiveNext(ARCHIVE_READER *r, char *path, size_t pathSize, void *data, size_t max, ssize_t *size)
+{
+    while(true)
+    {
+        USTAR_HEADER hdr;
+        if(!readAll(r->fd, &hdr, sizeof(hdr)))
+            break;
+
+        // The end of archive marker. Drain the padding after it, so the writer of a pipe doesn't get a SIGPIPE
+        if(memcmp(&hdr, zeros, sizeof(hdr)) == 0)
+        {
+            while(readAll(r->fd, NULL, BLOCK_SIZE))
+                ;
+
+            return 0;
+        }
+
+        uint64_t checksum, entrySize;
+        unsigned int sum = 0;
+        for(size_t i = 0; i < sizeof(hdr); i++)
+            sum += i >= offsetof(USTAR_HEADER, checksum) && i < offsetof(USTAR_HEADER, type) ? ' ' : ((const uint8_t *)&hdr)[i];
+
+        if(!headerNumber(hdr.checksum, sizeof(hdr.checksum), &checksum) || checksum != sum ||
+           !headerNumber(hdr.size, sizeof(hdr.size), &entrySize) || entrySize > SSIZE_MAX)
+        {
+            fprintf(stderr, "Broken header in the input archive\n");
+            return -1;
+        }
+
+        size_t padding = (BLOCK_SIZE - entrySize % BLOCK_SIZE) % BLOCK_SIZE;
+        if(hdr.type == 'L')
+        {
+            // GNU long name for the next entry, keep what fits
+            size_t n = entrySize < sizeof(r->longName) - 1 ? entrySize : sizeof(r->longName) - 1;
+            if(!readAll(r->fd, r->longName, n) || !readAll(r->fd, NULL, entrySize - n + padding))
+                break;
+
+            r->longName[n] = '\0';
+            continue;
+        }
+
+        if(hdr.type == 'x')
+        {
+            // pax header for the next entry, only the path record counts and only if it's in the first block
+            char pax[BLOCK_SIZE + 1];
+            size_t n = entrySize < BLOCK_SIZE ? entrySize : BLOCK_SIZE;
+            if(!readAll(r->fd, pax, n) || !readAll(r->fd, NULL, entrySize - n + padding))
+                break;
+
+            pax[n] = '\0';
+            r->longName[0] = '\0';
+            paxPath(r, pax, n);
+            continue;
+        }
+
+        if(hdr.type != '0' && hdr.type != '\0')
+        {
+            r->longName[0] = '\0';
+            if(!readAll(r->fd, NULL, entrySize + padding))
+                break;
+
+            continue;
+        }
+
+        if(r->longName[0] != '\0')
+            snprintf(path, pathSize, "%s", r->longName);
+        else if(memcmp(hdr.magic, "ustar", 5) == 0 && hdr.prefix[0] != '\0')
+            snprintf(path, pathSize, "%.*s/%.*s", (int)sizeof(hdr.prefix), hdr.prefix, (int)sizeof(hdr.name), hdr.name);
+        else
+            snprintf(path, pathSize, "%.*s", (int)sizeof(hdr.name), hdr.name);
+
+        r->longName[0] = '\0';
+        size_t n = entrySize < max ? entrySize : max;
+        if(!readAll(r->fd, data, n) || !readAll(r->fd, NULL, entrySize - n + padding))
+            break;
+
+        *size = entrySize;
+        return 1;
+    }
+
+    fprintf(stderr, "Error reading the input archive: %s\n", errno ? strerror(errno) : "Unexpected end");
+    return -1;
+}
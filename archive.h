@@ -0,0 +1,40 @@
+#pragma once
+
+#include <pthread.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <time.h>
+
+/*
+ * ustar archive writer
+ *
+ * Entries get appended in one writev() each, under a lock, so any number of workers can share an archive
+ * and the file is written strictly sequentially.
+ */
+typedef struct
+{
+    int fd;
+    size_t size;
+    time_t mtime;
+    pthread_mutex_t lock;
+} ARCHIVE;
+
+/*
+ * Sequential tar reader for pipes (ustar and GNU tar)
+ *
+ * Never seeks and only ever holds one block, anything that isn't a regular file gets skipped. Long names from GNU
+ * 'L' entries and pax path records are supported, the rest of pax extended headers is ignored.
+ */
+typedef struct
+{
+    int fd;
+    char longName[256]; // Name for the next entry from a GNU 'L' entry or a pax header, empty if none
+} ARCHIVE_READER;
+
+bool archiveOpen(ARCHIVE *a, const char *file);
+void archiveOpenFd(ARCHIVE *a, int fd);
+bool archiveAddDir(ARCHIVE *a, const char *path);
+bool archiveAdd(ARCHIVE *a, const char *path, const void *data, size_t size);
+bool archiveClose(ARCHIVE *a);
+void archiveReaderInit(ARCHIVE_READER *r, int fd);
+int archiveNext(ARCHIVE_READER *r, char *path, size_t pathSize, void *data, size_t max, ssize_t *size);
@@ -0,0 +1,460 @@
+/*
+ * End-to-end benchmark harness
+ *
+ * Runs diagConv over a corpus in each conversion mode and reports files/s, MB/s, syscalls per file and peak RSS.
+ * Each mode runs in a fresh output folder, the best of the timed runs counts. The syscalls get counted in an extra
+ * run under ptrace(), so the tracing overhead doesn't end up in the timings. They include the process startup.
+ *
+ * With --read it compares the input paths instead: The stdio one process() used before (fopen, fseek/ftell for the
+ * size, fread) against the open/read/close of readInput(), in wall time and syscalls per file over the same corpus.
+ */
+
+#define _GNU_SOURCE // nftw(), __WALL
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ptrace.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Like INPUT_MAX of diagConv */
+#define READ_MAX 4096
+
+typedef struct
+{
+    double seconds;
+    long maxRss; // KiB
+    uint64_t syscalls;
+} RESULT;
+
+static int removeEntry(const char *path, const struct stat *st, int flag, struct FTW *ftw)
+{
+    (void)st;
+    (void)flag;
+    (void)ftw;
+    return remove(path);
+}
+
+/* Empties the output folder, so every run has to create the same files */
+static bool cleanDir(const char *dir)
+{
+    if(nftw(dir, removeEntry, 16, FTW_DEPTH | FTW_PHYS) == -1 && errno != ENOENT)
+        return false;
+
+    return mkdir(dir, 0777) == 0;
+}
+
+/* Child side: Runs diagConv in the output folder with its output going nowhere */
+static void runChild(const char *dir, char *const argv[], bool trace)
+{
+    int null = open("/dev/null", O_WRONLY);
+    if(chdir(dir) == -1 || null == -1 || dup2(null, STDOUT_FILENO) == -1)
+        _exit(127);
+
+    // The parent notices if this fails, as the child won't stop
+    if(trace && ptrace(PTRACE_TRACEME, 0, NULL, NULL) == 0)
+        raise(SIGSTOP);
+
+    execv(argv[0], argv);
+    _exit(127);
+}
+
+/* Counts the syscalls of a traced child and all its threads until it exits */
+static bool traceChild(pid_t pid, RESULT *res, int *status)
+{
+    if(waitpid(pid, status, 0) != pid || !WIFSTOPPED(*status))
+        return false;
+
+    ptrace(PTRACE_SETOPTIONS, pid, NULL, PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEEXEC | PTRACE_O_EXITKILL);
+    ptrace(PTRACE_SYSCALL, pid, NULL, NULL);
+    while(true)
+    {
+        struct rusage ru;
+        pid_t tid = wait4(-1, status, __WALL, &ru);
+        if(tid == -1)
+            return false;
+
+        if(WIFEXITED(*status) || WIFSIGNALED(*status))
+        {
+            if(tid != pid)
+                continue;
+
+            res->maxRss = ru.ru_maxrss;
+            return true;
+        }
+
+        int sig = WSTOPSIG(*status);
+        if(sig == (SIGTRAP | 0x80))
+        {
+            struct __ptrace_syscall_info info;
+            if(ptrace(PTRACE_GET_SYSCALL_INFO, tid, sizeof(info), &info) > 0 && info.op == PTRACE_SYSCALL_INFO_ENTRY)
+                res->syscalls++;
+
+            sig = 0;
+        }
+        else if(sig == SIGTRAP || sig == SIGSTOP)
+            sig = 0; // ptrace events and new threads starting
+
+        ptrace(PTRACE_SYSCALL, tid, NULL, (void *)(long)sig);
+    }
+}
+
+/* Runs diagConv once, timing it respectively counting its syscalls */
+static bool run(const char *dir, char *const argv[], bool trace, RESULT *res)
+{
+    if(!cleanDir(dir))
+    {
+        fprintf(stderr, "Error creating %s\n", dir);
+        return false;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pid_t pid = fork();
+    if(pid == 0)
+        runChild(dir, argv, trace);
+    if(pid == -1)
+        return false;
+
+    int status;
+    memset(res, 0, sizeof(RESULT));
+    if(trace)
+    {
+        if(!traceChild(pid, res, &status))
+        {
+            fprintf(stderr, "Error tracing %s: %s\n", argv[0], strerror(errno));
+            return false;
+        }
+    }
+    else
+    {
+        struct rusage ru;
+        if(wait4(pid, &status, 0, &ru) != pid)
+            return false;
+
+        res->maxRss = ru.ru_maxrss;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    res->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        fprintf(stderr, "%s failed\n", argv[0]);
+        return false;
+    }
+
+    return true;
+}
+
+/* The input path process() used before: The size from fseek()/ftell(), then fread() */
+static bool readStdio(const char *file, uint8_t *buf)
+{
+    FILE *f = fopen(file, "rb");
+    if(f == NULL)
+        return false;
+
+    bool ret = false;
+    if(fseek(f, 0L, SEEK_END) == 0)
+    {
+        long filesize = ftell(f);
+        if(filesize > 0 && filesize < READ_MAX && fseek(f, 0L, SEEK_SET) == 0)
+            ret = fread(buf, filesize, 1, f) == 1;
+    }
+
+    fclose(f);
+    return ret;
+}
+
+/* The one of readInput(): A single read(), a short read tells the size */
+static bool readPlain(const char *file, uint8_t *buf)
+{
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+        return false;
+
+    ssize_t filesize = read(fd, buf, READ_MAX);
+    close(fd);
+    return filesize > 0 && filesize < READ_MAX;
+}
+
+typedef struct
+{
+    const char *name;
+    bool (*read)(const char *file, uint8_t *buf);
+} READ_PATH;
+
+static const READ_PATH readPaths[] = {
+    { "stdio", readStdio },
+    { "read()", readPlain },
+};
+
+/* Reads all files of the corpus with one of the paths */
+static bool readAll(const READ_PATH *path, char **list, size_t files)
+{
+    uint8_t buf[READ_MAX];
+    for(size_t i = 0; i < files; i++)
+    {
+        if(!path->read(list[i], buf))
+        {
+            fprintf(stderr, "Error reading %s with %s\n", list[i], path->name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Counts the syscalls of a pass over the corpus in a traced child, the file list got made before the fork */
+static bool traceReads(const READ_PATH *path, char **list, size_t files, RESULT *res)
+{
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        if(ptrace(PTRACE_TRACEME, 0, NULL, NULL) == 0)
+            raise(SIGSTOP);
+
+        _exit(readAll(path, list, files) ? 0 : 1);
+    }
+    if(pid == -1)
+        return false;
+
+    int status;
+    memset(res, 0, sizeof(RESULT));
+    if(!traceChild(pid, res, &status))
+    {
+        fprintf(stderr, "Error tracing the %s pass: %s\n", path->name, strerror(errno));
+        return false;
+    }
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/* Lists the .bin files of the corpus, NULL if there are none */
+static char **listCorpus(const char *path, size_t *files)
+{
+    DIR *dir = opendir(path);
+    if(dir == NULL)
+        return NULL;
+
+    char **list = NULL;
+    size_t size = 0;
+    *files = 0;
+    struct dirent *entry;
+    while((entry = readdir(dir)) != NULL)
+    {
+        size_t len = strlen(entry->d_name);
+        if(len != 10 || strcmp(entry->d_name + 6, ".bin") != 0)
+            continue;
+
+        if(*files == size)
+        {
+            size = size == 0 ? 1024 : size * 2;
+            char **tmp = realloc(list, sizeof(char *) * size);
+            if(tmp == NULL)
+                break;
+
+            list = tmp;
+        }
+
+        size_t pathLen = strlen(path) + 1 + len + 1;
+        list[*files] = malloc(pathLen);
+        if(list[*files] == NULL)
+            break;
+
+        snprintf(list[*files], pathLen, "%s/%s", path, entry->d_name);
+        (*files)++;
+    }
+
+    closedir(dir);
+    if(*files == 0)
+    {
+        free(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+/* --read: Wall time and syscalls per file of both input paths */
+static int readBench(const char *corpus, int runs)
+{
+    size_t files;
+    char **list = listCorpus(corpus, &files);
+    if(list == NULL)
+    {
+        fprintf(stderr, "Nothing to benchmark\n");
+        return 1;
+    }
+
+    printf("%zu files, best of %d runs\n\n", files, runs);
+    printf("path     us/file  syscalls/file\n");
+    int ret = 0;
+    for(size_t p = 0; ret == 0 && p < sizeof(readPaths) / sizeof(readPaths[0]); p++)
+    {
+        // One pass to get the files into the page cache
+        if(!readAll(readPaths + p, list, files))
+        {
+            ret = 1;
+            break;
+        }
+
+        double best = 0.0;
+        for(int i = 0; i < runs; i++)
+        {
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            readAll(readPaths + p, list, files);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+            if(i == 0 || seconds < best)
+                best = seconds;
+        }
+
+        RESULT res;
+        char syscalls[32] = "n/a";
+        if(traceReads(readPaths + p, list, files, &res))
+            snprintf(syscalls, sizeof(syscalls), "%.1f", (double)res.syscalls / files);
+
+        printf("%-6s %9.2f %14s\n", readPaths[p].name, best * 1e6 / files, syscalls);
+    }
+
+    for(size_t i = 0; i < files; i++)
+        free(list[i]);
+
+    free(list);
+    return ret;
+}
+
+/* Counts the .bin files of the corpus and their size */
+static bool scanCorpus(const char *path, size_t *files, uint64_t *bytes)
+{
+    DIR *dir = opendir(path);
+    if(dir == NULL)
+        return false;
+
+    *files = 0;
+    *bytes = 0;
+    struct dirent *entry;
+    while((entry = readdir(dir)) != NULL)
+    {
+        struct stat st;
+        size_t len = strlen(entry->d_name);
+        if(len != 10 || strcmp(entry->d_name + 6, ".bin") != 0 || fstatat(dirfd(dir), entry->d_name, &st, 0) == -1)
+            continue;
+
+        (*files)++;
+        *bytes += st.st_size;
+    }
+
+    closedir(dir);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int runs = 3;
+    int first = 1;
+    if(argc > 3 && strcmp(argv[1], "-r") == 0)
+    {
+        runs = atoi(argv[2]);
+        first = 3;
+    }
+
+    if(argc - first == 2 && strcmp(argv[first], "--read") == 0 && runs >= 1)
+        return readBench(argv[first + 1], runs);
+
+    if(argc - first < 2 || runs < 1)
+    {
+        fprintf(stderr, "Usage: %s [-r runs] corpus/path path/to/diagConv [diagConv options]\n", argv[0]);
+        fprintf(stderr, "       %s [-r runs] --read corpus/path\n", argv[0]);
+        return 1;
+    }
+
+    // diagConv runs in another folder, so make the paths absolute
+    char *corpus = realpath(argv[first], NULL);
+    char *prog = realpath(argv[first + 1], NULL);
+    size_t files;
+    uint64_t bytes;
+    if(corpus == NULL || prog == NULL || !scanCorpus(corpus, &files, &bytes) || files == 0)
+    {
+        fprintf(stderr, "Nothing to benchmark\n");
+        return 1;
+    }
+
+    char dict[strlen(corpus) + sizeof("/bench.dict")];
+    snprintf(dict, sizeof(dict), "%s/bench.dict", corpus);
+    bool useDict = access(dict, R_OK) == 0;
+
+    char dir[] = "/tmp/diagConvBench.XXXXXX";
+    if(mkdtemp(dir) == NULL)
+    {
+        fprintf(stderr, "Error creating a temporary folder\n");
+        return 1;
+    }
+
+    // prog, the mode flags, --dict file, the extra options, the corpus
+    int extra = argc - first - 2;
+    char *args[1 + 2 + 2 + extra + 1 + 1];
+    int n = 0;
+    char modes[2][3] = { "-u", "-w" };
+    args[n++] = prog;
+    args[n++] = modes[0];
+    args[n++] = modes[1];
+    if(useDict)
+    {
+        args[n++] = "--dict";
+        args[n++] = dict;
+    }
+
+    for(int i = 0; i < extra; i++)
+        args[n++] = argv[first + 2 + i];
+
+    args[n++] = corpus;
+    args[n] = NULL;
+
+    printf("%zu files, %.1f MB%s, best of %d runs\n\n", files, bytes / 1e6, useDict ? " (with bench.dict)" : "", runs);
+    printf("mode     files/s      MB/s  syscalls/file  peak RSS (KiB)\n");
+    int ret = 0;
+    for(const char *m = "uir"; ret == 0 && *m; m++)
+    {
+        for(const char *c = "wcn"; ret == 0 && *c; c++)
+        {
+            modes[0][1] = *m;
+            modes[1][1] = *c;
+
+            RESULT best, res;
+            for(int i = 0; ret == 0 && i < runs; i++)
+            {
+                if(!run(dir, args, false, &res))
+                    ret = 1;
+                else if(i == 0 || res.seconds < best.seconds)
+                    best = res;
+            }
+
+            if(ret != 0)
+                break;
+
+            // Without ptrace() (seccomp, containers) there are no syscall counts
+            char syscalls[32] = "n/a";
+            if(run(dir, args, true, &res))
+                snprintf(syscalls, sizeof(syscalls), "%.1f", (double)res.syscalls / files);
+
+            printf("-%c -%c %11.0f %9.1f %14s %15ld\n", *m, *c, files / best.seconds, bytes / 1e6 / best.seconds, syscalls, best.maxRss);
+        }
+    }
+
+    nftw(dir, removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+    free(corpus);
+    free(prog);
+    return ret;
+}
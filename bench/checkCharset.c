@@ -0,0 +1,131 @@
+/*
+ * Differential test of the transcoders: make check
+ *
+ * Compares charsetToIso()/charsetToUtf8() (SSE4.1 where built with it) with charsetToIsoScalar()/charsetToUtf8Scalar()
+ * for every charset. Each string is a background of unmapped ASCII with a single byte or a pair of bytes put in,
+ * at every offset of every length up to MAX_LENGTH. That covers every lead byte and every byte pair at every
+ * position of a chunk, control codes whose arguments cross into the next chunk and tails shorter than 16 bytes.
+ * The outputs have to be bit-identical and no transcoder may write past the capacity it got.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "charset.h"
+
+// Two full chunks and a tail of every length
+#define MAX_LENGTH (16 * 2 + 15)
+#define GUARD 32
+#define GUARD_BYTE 0xA5
+
+typedef size_t (*TRANSCODER)(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity);
+
+typedef struct
+{
+    const char *name;
+    TRANSCODER fast;
+    TRANSCODER scalar;
+    size_t (*max)(size_t length);
+} DIRECTION;
+
+static size_t isoMax(size_t length)
+{
+    return CHARSET_ISO_MAX(length);
+}
+
+static size_t utf8Max(size_t length)
+{
+    return CHARSET_UTF8_MAX(length);
+}
+
+static const DIRECTION directions[] = {
+    { "ISO-8859-1", charsetToIso, charsetToIsoScalar, isoMax },
+    { "UTF-8", charsetToUtf8, charsetToUtf8Scalar, utf8Max },
+};
+
+static void dump(const char *what, const uint8_t *data, size_t size)
+{
+    fprintf(stderr, "%s:", what);
+    for(size_t i = 0; i < size; i++)
+        fprintf(stderr, " %02X", data[i]);
+
+    fprintf(stderr, "\n");
+}
+
+/* Runs both transcoders on src, returns false on any difference */
+static bool compare(const CHARSET *cs, const DIRECTION *d, const uint8_t *src, size_t length)
+{
+    uint8_t fast[CHARSET_UTF8_MAX(MAX_LENGTH) + GUARD];
+    uint8_t scalar[CHARSET_UTF8_MAX(MAX_LENGTH) + GUARD];
+    size_t capacity = d->max(length);
+    memset(fast + capacity, GUARD_BYTE, GUARD);
+    memset(scalar + capacity, GUARD_BYTE, GUARD);
+
+    size_t fastSize = d->fast(cs, src, length, fast, capacity);
+    size_t scalarSize = d->scalar(cs, src, length, scalar, capacity);
+    bool ret = fastSize == scalarSize && fastSize <= capacity && memcmp(fast, scalar, fastSize) == 0;
+    for(size_t i = capacity; ret && i < capacity + GUARD; i++)
+        ret = fast[i] == GUARD_BYTE && scalar[i] == GUARD_BYTE;
+
+    if(!ret)
+    {
+        fprintf(stderr, "Mismatch in %s, %s, length %zu\n", cs->name, d->name, length);
+        dump("Input", src, length);
+        dump("SIMD", fast, fastSize < capacity + GUARD ? fastSize : capacity + GUARD);
+        dump("Scalar", scalar, scalarSize < capacity + GUARD ? scalarSize : capacity + GUARD);
+    }
+
+    return ret;
+}
+
+int main()
+{
+    uint8_t src[MAX_LENGTH];
+    unsigned long long cases = 0;
+    for(size_t c = 0; c < charsetCount; c++)
+    {
+        const CHARSET *cs = charsets + c;
+
+        // Background: Some ASCII byte the charset leaves alone
+        uint8_t fill = 'a';
+        while(fill < 0x7F && (cs->control[fill] != CHARSET_TEXT || cs->iso[fill] != fill))
+            fill++;
+
+        for(size_t d = 0; d < sizeof(directions) / sizeof(directions[0]); d++)
+        {
+            for(size_t length = 1; length <= MAX_LENGTH; length++)
+            {
+                memset(src, fill, length);
+                for(size_t offset = 0; offset < length; offset++)
+                {
+                    for(int a = 0; a < 256; a++)
+                    {
+                        src[offset] = a;
+                        if(!compare(cs, directions + d, src, length))
+                            return 1;
+
+                        cases++;
+                        for(int b = 0; offset + 1 < length && b < 256; b++)
+                        {
+                            src[offset + 1] = b;
+                            if(!compare(cs, directions + d, src, length))
+                                return 1;
+
+                            cases++;
+                        }
+
+                        if(offset + 1 < length)
+                            src[offset + 1] = fill;
+                    }
+
+                    src[offset] = fill;
+                }
+            }
+        }
+    }
+
+    printf("%llu cases, SIMD and scalar transcoders match\n", cases);
+    return 0;
+}
@@ -0,0 +1,328 @@
+/*
+ * Synthetic corpus generator for the benchmarks
+ *
+ * Writes count random .bin files with the same layout and mix of dialogs, quizzes and Grunty quizzes as the game,
+ * using the names of the built-in dictionaries first. Bigger corpora get made up names and a dictionary file
+ * (bench.dict in the output folder, see dictionary.h) which has to be given to diagConv with --dict.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "dialogDic.h"
+#include "dictionary.h"
+#include "quizDic.h"
+
+#define OUT_MAX 4096
+
+typedef struct
+{
+    uint32_t key;
+    uint16_t value;
+} ENTRY;
+
+static uint64_t rngState;
+
+/* xorshift64*, so a seed always gives the same corpus */
+static uint32_t rng(uint32_t range)
+{
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return ((rngState * 0x2545F4914F6CDD1D) >> 32) % range;
+}
+
+static uint32_t hexValue(const char *in, size_t len)
+{
+    uint32_t ret = 0;
+    for(size_t i = 0; i < len; i++)
+        ret = (ret << 4) | (in[i] <= '9' ? in[i] - '0' : in[i] - 'A' + 10);
+
+    return ret;
+}
+
+/* Same as in dictionary.c */
+static uint32_t entryChecksum(DIC_TYPE type, uint32_t key, uint16_t value)
+{
+    uint8_t data[] = { type, key, key >> 8, key >> 16, value, value >> 8 };
+    uint32_t hash = 0x811C9DC5;
+    for(size_t i = 0; i < sizeof(data); i++)
+    {
+        hash ^= data[i];
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+/*
+ * Appends a message with a random string
+ *
+ * Mostly text, some of it from the special characters at 0x5B - 0x6B, sometimes with a control code or a stop code.
+ */
+static size_t message(uint8_t *out, uint8_t cmd)
+{
+    static const char text[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ      .,!?'";
+    size_t length = rng(80);
+    uint8_t *s = out + 2;
+    for(size_t i = 0; i < length; i++)
+        s[i] = rng(20) == 0 ? 0x5B + rng(0x11) : (uint8_t)text[rng(sizeof(text) - 1)];
+
+    if(length > 4 && rng(5) == 0)
+    {
+        size_t p = rng(length - 2);
+        s[p] = 0xFD;
+        s[p + 1] = "l\\A"[rng(3)];
+    }
+
+    if(length > 4 && rng(10) == 0)
+        s[length - 2] = 0xFC;
+
+    s[length] = '\0';
+    out[0] = cmd;
+    out[1] = length + 1;
+    return length + 3;
+}
+
+/* A message list, cmds are picked from the given ones */
+static size_t messages(uint8_t *out, unsigned int min, unsigned int max, const uint8_t *cmds, size_t cmdCount)
+{
+    uint8_t count = min + rng(max - min + 1);
+    size_t size = 1;
+    out[0] = count;
+    for(uint8_t i = 0; i < count; i++)
+        size += message(out + size, cmds[rng(cmdCount)]);
+
+    return size;
+}
+
+/* A whole .bin file, see parseDialog() and parseQuiz() for the layout */
+static size_t binFile(uint8_t *out, DIC_TYPE type)
+{
+    static const uint8_t bottomCmds[] = { 0x80, 0x81, 0x83, 0xC0, 0xCB, 0xBC, 0x08, 0x88, 0x04 };
+    static const uint8_t topCmds[] = { 0x80, 0x81, 0x07, 0x87 };
+    static const uint8_t answerCmds[] = { 0x81, 0x82, 0x83 };
+
+    size_t size;
+    if(type == DIC_DIALOG)
+    {
+        out[0] = 0x03;
+        size = 1;
+    }
+    else
+    {
+        out[0] = 0x03;
+        out[1] = type == DIC_GRUNTY ? 0x03 : 0x01;
+        out[2] = 0x00;
+        size = 3;
+    }
+
+    size_t offsets = size;
+    size += 6;
+    for(int i = 0; i < 3; i++)
+    {
+        out[offsets + i * 2] = size;
+        out[offsets + i * 2 + 1] = size >> 8;
+        if(type == DIC_DIALOG)
+        {
+            // At least two bottom messages, diagConv doesn't take files of 32 bytes or less
+            size += messages(out + size, 2, 6, bottomCmds, sizeof(bottomCmds));
+            size += messages(out + size, 0, 4, topCmds, sizeof(topCmds));
+            continue;
+        }
+
+        // The question followed by two to four answers
+        size_t count = size++;
+        out[count] = 3 + rng(3);
+        size += message(out + size, 0x80);
+        for(uint8_t j = 1; j < out[count]; j++)
+            size += message(out + size, answerCmds[rng(sizeof(answerCmds))]);
+    }
+
+    return size;
+}
+
+static int compareEntries(const void *a, const void *b)
+{
+    uint32_t ka = ((const ENTRY *)a)->key;
+    uint32_t kb = ((const ENTRY *)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+/* Writes the dictionary for made up names, see dictionary.h for the format */
+static bool writeDict(const char *file, ENTRY *entries[DIC_TYPES], const uint32_t count[DIC_TYPES])
+{
+    DICT_HEADER hdr = {
+        .magic = DICT_MAGIC,
+        .version = DICT_VERSION,
+        .reserved = 0,
+        .checksum = 0,
+    };
+
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        hdr.count[i] = count[i];
+        qsort(entries[i], count[i], sizeof(ENTRY), compareEntries);
+        for(uint32_t j = 0; j < count[i]; j++)
+            hdr.checksum += entryChecksum(i, entries[i][j].key, entries[i][j].value);
+    }
+
+    FILE *f = fopen(file, "wb");
+    if(f == NULL)
+        return false;
+
+    bool ret = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    for(int i = 0; ret && i < DIC_TYPES; i++)
+        for(uint32_t j = 0; ret && j < count[i]; j++)
+            ret = fwrite(&entries[i][j].key, sizeof(uint32_t), 1, f) == 1;
+
+    for(int i = 0; ret && i < DIC_TYPES; i++)
+        for(uint32_t j = 0; ret && j < count[i]; j++)
+            ret = fwrite(&entries[i][j].value, sizeof(uint16_t), 1, f) == 1;
+
+    return fclose(f) == 0 && ret;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2 || argc > 4)
+    {
+        fprintf(stderr, "Usage: %s out/path [count] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    unsigned long count = argc > 2 ? strtoul(argv[2], NULL, 10) : DIAG_LIST_MAX + QUIZ_LIST_MAX + GRUNTY_LIST_MAX;
+    rngState = argc > 3 ? strtoull(argv[3], NULL, 10) : 1;
+    if(rngState == 0)
+        rngState = 1;
+
+    if(mkdir(argv[1], 0777) == -1 && errno != EEXIST)
+    {
+        fprintf(stderr, "Error creating %s\n", argv[1]);
+        return 1;
+    }
+
+    // Split the count like the game does, the built-in names first
+    static const struct
+    {
+        const char (*in)[6];
+        const char (*out)[4];
+        uint32_t count;
+    } lists[DIC_TYPES] = {
+        { diagInList, diagOutList, DIAG_LIST_MAX },
+        { quizInList, quizOutList, QUIZ_LIST_MAX },
+        { gruntyInList, gruntyOutList, GRUNTY_LIST_MAX },
+    };
+
+    uint32_t total = DIAG_LIST_MAX + QUIZ_LIST_MAX + GRUNTY_LIST_MAX;
+    uint32_t counts[DIC_TYPES];
+    counts[DIC_QUIZ] = (uint64_t)count * QUIZ_LIST_MAX / total;
+    counts[DIC_GRUNTY] = (uint64_t)count * GRUNTY_LIST_MAX / total;
+    counts[DIC_DIALOG] = count - counts[DIC_QUIZ] - counts[DIC_GRUNTY];
+
+    // The output names are 16 bit, what doesn't fit goes to the next type
+    for(int i = 0; i < DIC_TYPES - 1; i++)
+    {
+        if(counts[i] > 0x10000)
+        {
+            counts[i + 1] += counts[i] - 0x10000;
+            counts[i] = 0x10000;
+        }
+    }
+
+    ENTRY *entries[DIC_TYPES];
+    bool extra = false;
+    static uint8_t usedKey[1 << 24 >> 3];
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        if(counts[i] > 0x10000)
+        {
+            fprintf(stderr, "Too many files, at most %d\n", 0x10000 * DIC_TYPES);
+            return 1;
+        }
+
+        entries[i] = malloc(sizeof(ENTRY) * (counts[i] > lists[i].count ? counts[i] : lists[i].count));
+        if(entries[i] == NULL)
+        {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+
+        for(uint32_t j = 0; j < lists[i].count; j++)
+        {
+            entries[i][j].key = hexValue(lists[i].in[j], 6);
+            entries[i][j].value = hexValue(lists[i].out[j], 4);
+            usedKey[entries[i][j].key >> 3] |= 1 << (entries[i][j].key & 7);
+        }
+
+        extra = extra || counts[i] > lists[i].count;
+    }
+
+    // Made up names: Unused keys and values, so nothing overwrites anything else
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        static uint8_t usedValue[0x10000];
+        memset(usedValue, 0, sizeof(usedValue));
+        for(uint32_t j = 0; j < lists[i].count; j++)
+            usedValue[entries[i][j].value] = 1;
+
+        uint32_t value = 0;
+        for(uint32_t j = lists[i].count; j < counts[i]; j++)
+        {
+            uint32_t key;
+            do
+                key = rng(1 << 24);
+            while(usedKey[key >> 3] & (1 << (key & 7)));
+
+            usedKey[key >> 3] |= 1 << (key & 7);
+            while(usedValue[value])
+                value++;
+
+            entries[i][j].key = key;
+            entries[i][j].value = value++;
+        }
+    }
+
+    size_t pl = strlen(argv[1]);
+    char path[pl + sizeof("/XXXXXX.bin")];
+    uint8_t buf[OUT_MAX];
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        for(uint32_t j = 0; j < counts[i]; j++)
+        {
+            snprintf(path, sizeof(path), "%s/%06X.bin", argv[1], entries[i][j].key);
+            size_t size = binFile(buf, i);
+            FILE *f = fopen(path, "wb");
+            if(f == NULL || fwrite(buf, 1, size, f) != size || fclose(f) != 0)
+            {
+                fprintf(stderr, "Error writing %s\n", path);
+                return 1;
+            }
+        }
+    }
+
+    if(extra)
+    {
+        for(int i = 0; i < DIC_TYPES; i++)
+            if(counts[i] < lists[i].count)
+                counts[i] = lists[i].count;
+
+        char dict[pl + sizeof("/bench.dict")];
+        snprintf(dict, sizeof(dict), "%s/bench.dict", argv[1]);
+        if(!writeDict(dict, entries, counts))
+        {
+            fprintf(stderr, "Error writing %s\n", dict);
+            return 1;
+        }
+    }
+
+    for(int i = 0; i < DIC_TYPES; i++)
+        free(entries[i]);
+
+    printf("Wrote %lu files to %s%s\n", count, argv[1], extra ? " (use bench.dict)" : "");
+    return 0;
+}
@@ -0,0 +1,400 @@
+/*
+ * Microbenchmarks for the hot kernels
+ *
+ * Each kernel runs over fixed in-memory inputs, so there's no filesystem noise. Reports ns/op and, if
+ * perf_event_open() is allowed (see /proc/sys/kernel/perf_event_paranoid), cycles, instructions and branch misses per op.
+ * Gets linked against the objects of diagConv, so it measures exactly what diagConv runs.
+ */
+
+#define _GNU_SOURCE // syscall()
+
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "charset.h"
+#include "convert.h"
+#include "dialogDic.h"
+#include "dictionary.h"
+#include "emitter.h"
+#include "quizDic.h"
+
+#define STRINGS 1024
+#define STRING_LENGTH 64
+#define BLOBS 64
+
+typedef enum
+{
+    COUNTER_CYCLES,
+    COUNTER_INSTRUCTIONS,
+    COUNTER_BRANCH_MISSES,
+    COUNTERS
+} COUNTER;
+
+/* A group of hardware counters, fd[0] is the leader. -1 if perf_event_open() isn't available */
+typedef struct
+{
+    int fd[COUNTERS];
+} COUNTER_GROUP;
+
+typedef struct
+{
+    const char *name;
+    size_t (*run)(void); // Runs one pass over the inputs, returns the number of ops
+} KERNEL;
+
+static const uint64_t counterConfig[COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES };
+
+static DICTIONARY builtinDic, fileDic;
+static const CHARSET *charset;
+static char names[DIC_TYPES][DIAG_LIST_MAX][6];
+static uint32_t nameCount[DIC_TYPES];
+static uint8_t strings[STRINGS][STRING_LENGTH];
+static uint8_t dst[CHARSET_UTF8_MAX(STRING_LENGTH)];
+static EMITTER emitter;
+static char printBuf[STRINGS * (STRING_LENGTH + 32)];
+static FILE *printFile;
+static uint8_t blobs[BLOBS][INPUT_MAX];
+static char blobNames[BLOBS][7];
+static CONFIG config;
+static OUTPUT output;
+static volatile size_t sink; // Keeps the compiler from dropping results
+
+static uint64_t rngState = 1;
+
+static uint32_t rng(uint32_t range)
+{
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return ((rngState * 0x2545F4914F6CDD1D) >> 32) % range;
+}
+
+static void openCounters(COUNTER_GROUP *g)
+{
+    for(int i = 0; i < COUNTERS; i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = counterConfig[i];
+        attr.disabled = i == 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        g->fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : g->fd[0], 0);
+        if(g->fd[i] == -1)
+        {
+            for(int j = 0; j < i; j++)
+                close(g->fd[j]);
+
+            g->fd[0] = -1;
+            return;
+        }
+    }
+}
+
+static void closeCounters(COUNTER_GROUP *g)
+{
+    if(g->fd[0] == -1)
+        return;
+
+    for(int i = 0; i < COUNTERS; i++)
+        close(g->fd[i]);
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Runs a kernel for about 200 ms after a warm up and prints its numbers */
+static void measure(const KERNEL *k, COUNTER_GROUP *g)
+{
+    size_t ops = 0;
+    for(int i = 0; i < 16; i++)
+        ops += k->run();
+
+    // Scale the passes so the measurement takes long enough for the timer
+    double start = now();
+    size_t passes = 0;
+    while(now() - start < 20e6)
+    {
+        k->run();
+        passes++;
+    }
+
+    passes *= 10;
+    if(g->fd[0] != -1)
+    {
+        ioctl(g->fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(g->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ops = 0;
+    start = now();
+    for(size_t i = 0; i < passes; i++)
+        ops += k->run();
+
+    double ns = now() - start;
+    printf("%-24s %10.1f", k->name, ns / ops);
+    if(g->fd[0] == -1)
+    {
+        printf(" %12s %12s %12s\n", "n/a", "n/a", "n/a");
+        return;
+    }
+
+    ioctl(g->fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t values[1 + COUNTERS];
+    if(read(g->fd[0], values, sizeof(values)) != sizeof(values))
+    {
+        printf(" %12s %12s %12s\n", "n/a", "n/a", "n/a");
+        return;
+    }
+
+    for(int i = 0; i < COUNTERS; i++)
+        printf(" %12.2f", (double)values[1 + i] / ops);
+
+    printf("\n");
+}
+
+/* Kernels */
+
+static size_t lookup(const DICTIONARY *dic)
+{
+    char out[4];
+    size_t hits = 0;
+    for(int t = 0; t < DIC_TYPES; t++)
+        for(uint32_t i = 0; i < nameCount[t]; i++)
+            hits += mapName(dic, t, names[t][i], out) != DIC_MISS;
+
+    sink = hits;
+    return nameCount[DIC_DIALOG] + nameCount[DIC_QUIZ] + nameCount[DIC_GRUNTY];
+}
+
+static size_t lookupBuiltin()
+{
+    return lookup(&builtinDic);
+}
+
+static size_t lookupFile()
+{
+    return lookup(&fileDic);
+}
+
+static size_t transcode(size_t (*fn)(const CHARSET *, const uint8_t *, size_t, uint8_t *, size_t), size_t capacity)
+{
+    size_t total = 0;
+    for(int i = 0; i < STRINGS; i++)
+        total += fn(charset, strings[i], STRING_LENGTH, dst, capacity);
+
+    sink = total;
+    return STRINGS;
+}
+
+static size_t toIso()
+{
+    return transcode(charsetToIso, CHARSET_ISO_MAX(STRING_LENGTH));
+}
+
+static size_t toIsoScalar()
+{
+    return transcode(charsetToIsoScalar, CHARSET_ISO_MAX(STRING_LENGTH));
+}
+
+static size_t toUtf8()
+{
+    return transcode(charsetToUtf8, CHARSET_UTF8_MAX(STRING_LENGTH));
+}
+
+static size_t toUtf8Scalar()
+{
+    return transcode(charsetToUtf8Scalar, CHARSET_UTF8_MAX(STRING_LENGTH));
+}
+
+static size_t emit()
+{
+    emitterReset(&emitter);
+    for(int i = 0; i < STRINGS; i++)
+        emitMessage(&emitter, 0x80, "", 0, (const char *)strings[i], STRING_LENGTH);
+
+    sink = emitter.size;
+    return STRINGS;
+}
+
+/* The same lines the way they got written before the emitter: fprintf() into a stdio stream, in memory here */
+static size_t emitPrintf()
+{
+    rewind(printFile);
+    for(int i = 0; i < STRINGS; i++)
+        fprintf(printFile, "  - { cmd: 0x%02X, string: \"%.*s\" }\n", 0x80, STRING_LENGTH, (const char *)strings[i]);
+
+    sink = ftell(printFile);
+    return STRINGS;
+}
+
+static bool discardOutput(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset)
+{
+    (void)language;
+    (void)type;
+    (void)path;
+    (void)nameOffset;
+    sink = out->buf.size;
+    return true;
+}
+
+/* A whole file: Lookup, transcoding and rendering of all three languages, without the I/O */
+static size_t render()
+{
+    for(int i = 0; i < BLOBS; i++)
+        parseBlob(blobs[i], blobNames[i], blobNames[i], &config, &output);
+
+    return BLOBS;
+}
+
+/* Inputs */
+
+static size_t message(uint8_t *out, uint8_t cmd, const uint8_t *str)
+{
+    out[0] = cmd;
+    out[1] = STRING_LENGTH + 1;
+    memcpy(out + 2, str, STRING_LENGTH);
+    out[2 + STRING_LENGTH] = '\0';
+    return STRING_LENGTH + 3;
+}
+
+/* Dialogs with four bottom and two top messages, quizzes with a question and three answers */
+static void makeBlob(uint8_t *blob, DIC_TYPE type)
+{
+    size_t size = type == DIC_DIALOG ? 1 : 3;
+    memcpy(blob, type == DIC_DIALOG ? "\x03" : type == DIC_QUIZ ? "\x03\x01\x00" : "\x03\x03\x00", size);
+    size_t offsets = size;
+    size += 6;
+    for(int i = 0; i < 3; i++)
+    {
+        blob[offsets + i * 2] = size;
+        blob[offsets + i * 2 + 1] = size >> 8;
+        if(type == DIC_DIALOG)
+        {
+            blob[size++] = 4;
+            for(int j = 0; j < 4; j++)
+                size += message(blob + size, (const uint8_t[]){ 0x80, 0xC0, 0x08, 0x04 }[j], strings[rng(STRINGS)]);
+
+            blob[size++] = 2;
+            for(int j = 0; j < 2; j++)
+                size += message(blob + size, 0x81, strings[rng(STRINGS)]);
+        }
+        else
+        {
+            blob[size++] = 4;
+            for(int j = 0; j < 4; j++)
+                size += message(blob + size, j ? 0x81 : 0x80, strings[rng(STRINGS)]);
+        }
+    }
+}
+
+static bool setup()
+{
+    dictionaryInit(&builtinDic);
+    charset = charsetFind(CHARSET_DEFAULT);
+
+    // Shuffled names with one in eight missing
+    const char (*lists[DIC_TYPES])[6] = { diagInList, quizInList, gruntyInList };
+    const uint32_t sizes[DIC_TYPES] = { DIAG_LIST_MAX, QUIZ_LIST_MAX, GRUNTY_LIST_MAX };
+    for(int t = 0; t < DIC_TYPES; t++)
+    {
+        nameCount[t] = sizes[t];
+        for(uint32_t i = 0; i < sizes[t]; i++)
+        {
+            memcpy(names[t][i], lists[t][rng(sizes[t])], 6);
+            if(rng(8) == 0)
+                names[t][i][0] = 'F';
+        }
+    }
+
+    // Text with some of the special characters, control and stop codes
+    for(int i = 0; i < STRINGS; i++)
+    {
+        for(int j = 0; j < STRING_LENGTH; j++)
+            strings[i][j] = rng(10) == 0 ? 0x5B + rng(0x11) : 'a' + rng(26);
+
+        if(rng(4) == 0)
+            memcpy(strings[i] + rng(STRING_LENGTH - 1), "\xFDl", 2);
+        if(rng(16) == 0)
+            strings[i][STRING_LENGTH - 4] = 0xFC;
+    }
+
+    for(int i = 0; i < BLOBS; i++)
+    {
+        DIC_TYPE type = i % 8 == 7 ? DIC_QUIZ : i % 16 == 15 ? DIC_GRUNTY : DIC_DIALOG;
+        const char *name = type == DIC_DIALOG ? diagInList[i] : type == DIC_QUIZ ? quizInList[i] : gruntyInList[i % GRUNTY_LIST_MAX];
+        memcpy(blobNames[i], name, 6);
+        blobNames[i][6] = '\0';
+        makeBlob(blobs[i], type);
+    }
+
+    config.convert = TO_UTF | TO_CON | TO_COM;
+    config.dic = &builtinDic;
+    config.charset = charset;
+    emitterInit(&output.buf);
+    output.write = discardOutput;
+    emitterInit(&emitter);
+    printFile = fmemopen(printBuf, sizeof(printBuf), "w");
+    if(printFile == NULL)
+        return false;
+
+    // The same dictionary as a file, to compare the binary search with the perfect hash
+    char file[] = "/tmp/diagConvMicro.XXXXXX";
+    int fd = mkstemp(file);
+    if(fd == -1)
+        return false;
+
+    close(fd);
+    bool ret = dictionaryWrite(&builtinDic, file) && dictionaryLoad(&fileDic, file);
+    unlink(file);
+    return ret;
+}
+
+int main()
+{
+    if(!setup())
+    {
+        fprintf(stderr, "Setup failed\n");
+        return 1;
+    }
+
+    static const KERNEL kernels[] = {
+        { "mapName (built-in)", lookupBuiltin },
+        { "mapName (--dict)", lookupFile },
+        { "charsetToIso", toIso },
+        { "charsetToIsoScalar", toIsoScalar },
+        { "charsetToUtf8", toUtf8 },
+        { "charsetToUtf8Scalar", toUtf8Scalar },
+        { "emitMessage", emit },
+        { "fprintf (baseline)", emitPrintf },
+        { "parseBlob (-u -c)", render },
+    };
+
+    COUNTER_GROUP g;
+    openCounters(&g);
+    printf("%d byte strings%s\n\n", STRING_LENGTH, g.fd[0] == -1 ? ", no hardware counters (perf_event_open() not allowed)" : "");
+    printf("%-24s %10s %12s %12s %12s\n", "kernel", "ns/op", "cycles/op", "instr/op", "br-miss/op");
+    for(size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++)
+        measure(kernels + i, &g);
+
+    closeCounters(&g);
+    dictionaryUnload(&fileDic);
+    emitterFree(&output.buf);
+    emitterFree(&emitter);
+    fclose(printFile);
+    return 0;
+}
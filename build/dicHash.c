@@ -0,0 +1,287 @@
+/* Generated by tools/genDicHash.c - do not edit */
+
+#include "dicHash.h"
+
+static const uint16_t diagDisplace[178] = {
+    2, 0, 7, 1, 35, 36, 55, 43, 546, 44, 4, 85, 0, 0, 119, 8,
+    0, 9, 3, 3, 2, 14, 5, 17, 8, 3, 36, 245, 0, 7, 26, 3,
+    81, 151, 73, 13, 0, 0, 0, 71, 20, 206, 221, 336, 8, 6, 431, 424,
+    1, 0, 23, 6, 278, 44, 0, 5, 0, 3, 23, 84, 42, 1, 14, 0,
+    41, 8, 6, 3, 1, 2, 4, 135, 81, 4, 1, 392, 73, 25, 0, 368,
+    19, 43, 131, 14, 164, 39, 133, 218, 4, 254, 35, 132, 738, 78, 5, 162,
+    241, 82, 940, 23, 98, 0, 166, 20, 136, 154, 0, 299, 231, 357, 189, 7,
+    367, 4, 4, 1, 466, 0, 3, 315, 151, 5, 1, 24, 0, 36, 264, 138,
+    49, 732, 0, 185, 291, 847, 310, 85, 73, 1091, 59, 30, 45, 526, 12, 184,
+    4, 650, 64, 613, 46, 1, 1, 185, 488, 242, 1373, 133, 2, 142, 94, 105,
+    727, 435, 195, 675, 441, 2606, 0, 509, 337, 208, 140, 151, 6, 369, 537, 396,
+    6, 734,
+};
+
+static const uint8_t diagEntries[712][5] = {
+    {0x30, 0x17, 0x5E, 0x5A, 0x0F}, {0xD8, 0xFE, 0x5D, 0x72, 0x0E}, {0x28, 0xD0, 0x5D, 0x23, 0x0E}, {0x70, 0xD8, 0x5D, 0x2D, 0x0E},
+    {0xF0, 0xCC, 0x5C, 0x79, 0x0A}, {0xC0, 0x74, 0x5E, 0x27, 0x10}, {0xA8, 0xA4, 0x5D, 0xFC, 0x0D}, {0xA0, 0xCD, 0x5C, 0x7A, 0x0A},
+    {0x50, 0xDB, 0x5D, 0x32, 0x0E}, {0xD8, 0x46, 0x5E, 0x99, 0x0F}, {0x58, 0x38, 0x5E, 0x85, 0x0F}, {0x88, 0x0F, 0x5F, 0xC9, 0x11},
+    {0xF0, 0xE0, 0x5D, 0x38, 0x0E}, {0x98, 0x4C, 0x5E, 0xA1, 0x0F}, {0x38, 0x4E, 0x5D, 0x96, 0x0C}, {0x90, 0xE5, 0x5C, 0x3B, 0x0B},
+    {0x98, 0x47, 0x5E, 0x9A, 0x0F}, {0xC0, 0x5A, 0x5D, 0xD5, 0x0C}, {0x90, 0xB4, 0x5E, 0xEF, 0x10}, {0xF0, 0x11, 0x5E, 0x92, 0x0E},
+    {0x58, 0xF4, 0x5E, 0x49, 0x11}, {0x50, 0xEF, 0x5E, 0x42, 0x11}, {0x00, 0x49, 0x5E, 0x9C, 0x0F}, {0x10, 0x8D, 0x5E, 0x84, 0x10},
+    {0xF8, 0xCE, 0x5E, 0x14, 0x11}, {0xF8, 0xAB, 0x5C, 0x0C, 0x0A}, {0x40, 0x03, 0x5E, 0x79, 0x0E}, {0xC0, 0xFB, 0x5E, 0x55, 0x11},
+    {0x00, 0xEA, 0x5C, 0x43, 0x0B}, {0xE0, 0xB0, 0x5C, 0x12, 0x0A}, {0x18, 0xE8, 0x5D, 0x3E, 0x0E}, {0x70, 0x58, 0x5D, 0xD2, 0x0C},
+    {0x70, 0xFF, 0x5E, 0x5A, 0x11}, {0xA0, 0xB3, 0x5D, 0x09, 0x0E}, {0x00, 0xA0, 0x5E, 0x97, 0x10}, {0xF8, 0xD6, 0x5D, 0x2A, 0x0E},
+    {0xB8, 0xC5, 0x5E, 0x07, 0x11}, {0x50, 0xC4, 0x5E, 0x05, 0x11}, {0x28, 0x92, 0x5D, 0xB3, 0x0D}, {0x00, 0x85, 0x5D, 0xA0, 0x0D},
+    {0xB8, 0x4B, 0x5D, 0x92, 0x0C}, {0x48, 0x85, 0x5E, 0x3C, 0x10}, {0xB0, 0xC4, 0x5D, 0x19, 0x0E}, {0x08, 0xFB, 0x5E, 0x54, 0x11},
+    {0xE0, 0xEC, 0x5C, 0x47, 0x0B}, {0x88, 0x0D, 0x5E, 0x8A, 0x0E}, {0x90, 0xC6, 0x5D, 0x1C, 0x0E}, {0x10, 0xF8, 0x5E, 0x51, 0x11},
+    {0x90, 0x51, 0x5D, 0xC8, 0x0C}, {0xB8, 0xFE, 0x5E, 0x59, 0x11}, {0x50, 0xF9, 0x5C, 0x4E, 0x0B}, {0xD0, 0x05, 0x5D, 0x02, 0x0C},
+    {0x90, 0xB9, 0x5E, 0xF6, 0x10}, {0x00, 0x99, 0x5E, 0x90, 0x10}, {0xF8, 0xA9, 0x5C, 0x0B, 0x0A}, {0x28, 0x67, 0x5E, 0xB6, 0x0F},
+    {0x08, 0xC5, 0x5E, 0x06, 0x11}, {0x78, 0xA5, 0x5E, 0x9C, 0x10}, {0x28, 0x70, 0x5D, 0x35, 0x0D}, {0xA8, 0xB1, 0x5C, 0x13, 0x0A},
+    {0xF0, 0xE6, 0x5E, 0x38, 0x11}, {0x88, 0x22, 0x5E, 0x6C, 0x0F}, {0x98, 0x0A, 0x5D, 0x08, 0x0C}, {0x78, 0xFC, 0x5E, 0x56, 0x11},
+    {0x50, 0xE4, 0x5C, 0x38, 0x0B}, {0x48, 0x01, 0x5E, 0x76, 0x0E}, {0x88, 0x5F, 0x5D, 0xDD, 0x0C}, {0x18, 0x0B, 0x5E, 0x86, 0x0E},
+    {0xC0, 0x2B, 0x5E, 0x77, 0x0F}, {0x70, 0xD9, 0x5E, 0x22, 0x11}, {0x58, 0xC0, 0x5D, 0x15, 0x0E}, {0x68, 0x45, 0x5E, 0x97, 0x0F},
+    {0x10, 0x3A, 0x5E, 0x87, 0x0F}, {0x80, 0x18, 0x5E, 0x5B, 0x0F}, {0x08, 0x82, 0x5D, 0x9C, 0x0D}, {0x68, 0x0E, 0x5E, 0x8B, 0x0E},
+    {0x08, 0x00, 0x5E, 0x74, 0x0E}, {0xD0, 0x14, 0x5D, 0x16, 0x0C}, {0xC0, 0x09, 0x5E, 0x84, 0x0E}, {0xB8, 0xBB, 0x5E, 0xF9, 0x10},
+    {0x50, 0x02, 0x5E, 0x78, 0x0E}, {0x90, 0x69, 0x5D, 0x2C, 0x0D}, {0xC0, 0xB4, 0x5C, 0x18, 0x0A}, {0x58, 0x56, 0x5D, 0xCF, 0x0C},
+    {0x60, 0xD0, 0x5E, 0x16, 0x11}, {0x28, 0x5E, 0x5D, 0xDB, 0x0C}, {0xF0, 0x5C, 0x5D, 0xD9, 0x0C}, {0x78, 0xFF, 0x5D, 0x73, 0x0E},
+    {0x50, 0x64, 0x5E, 0xB2, 0x0F}, {0x20, 0xC7, 0x5E, 0x09, 0x11}, {0x30, 0x4B, 0x5E, 0x9F, 0x0F}, {0xC0, 0xE3, 0x5C, 0x37, 0x0B},
+    {0x50, 0x77, 0x5D, 0x90, 0x0D}, {0x50, 0xFB, 0x5D, 0x6C, 0x0E}, {0x10, 0x57, 0x5E, 0xA8, 0x0F}, {0x00, 0x8B, 0x5D, 0xA9, 0x0D},
+    {0x60, 0xD2, 0x5C, 0x82, 0x0A}, {0x78, 0x0B, 0x5D, 0x09, 0x0C}, {0xE0, 0xC2, 0x5E, 0x03, 0x11}, {0x80, 0xA6, 0x5D, 0xFE, 0x0D},
+    {0x20, 0x30, 0x5D, 0x6D, 0x0C}, {0xC0, 0xA2, 0x5D, 0xFB, 0x0D}, {0x78, 0xF8, 0x5C, 0x4D, 0x0B}, {0x08, 0x78, 0x5D, 0x91, 0x0D},
+    {0x90, 0xDF, 0x5D, 0x36, 0x0E}, {0xC0, 0x7A, 0x5D, 0x95, 0x0D}, {0xC8, 0x78, 0x5E, 0x2C, 0x10}, {0x60, 0xAF, 0x5E, 0xE8, 0x10},
+    {0x00, 0x1D, 0x5E, 0x65, 0x0F}, {0xE0, 0xE5, 0x5D, 0x3C, 0x0E}, {0xC0, 0xF4, 0x5C, 0x4A, 0x0B}, {0x50, 0xED, 0x5D, 0x59, 0x0E},
+    {0x88, 0xE4, 0x5E, 0x36, 0x11}, {0x58, 0xE2, 0x5C, 0xE1, 0x0A}, {0x18, 0x36, 0x5D, 0x75, 0x0C}, {0x98, 0xC3, 0x5C, 0x29, 0x0A},
+    {0xD8, 0x17, 0x5D, 0x1B, 0x0C}, {0x10, 0xFC, 0x5D, 0x6E, 0x0E}, {0x20, 0x04, 0x5E, 0x7B, 0x0E}, {0x40, 0x39, 0x5D, 0x7A, 0x0C},
+    {0x20, 0xBD, 0x5E, 0xFB, 0x10}, {0xE8, 0xD2, 0x5D, 0x26, 0x0E}, {0xB0, 0x01, 0x5D, 0xA2, 0x0B}, {0x70, 0x5A, 0x5E, 0xAB, 0x0F},
+    {0x28, 0x7F, 0x5E, 0x34, 0x10}, {0x98, 0xEA, 0x5C, 0x44, 0x0B}, {0xC0, 0x48, 0x5D, 0x8F, 0x0C}, {0xF0, 0x74, 0x5D, 0x39, 0x0D},
+    {0x50, 0xF9, 0x5D, 0x69, 0x0E}, {0x50, 0xA3, 0x5E, 0x9A, 0x10}, {0xF8, 0x95, 0x5E, 0x8D, 0x10}, {0x68, 0xEF, 0x5D, 0x5C, 0x0E},
+    {0x88, 0xD6, 0x5E, 0x1E, 0x11}, {0xB0, 0xCF, 0x5E, 0x15, 0x11}, {0xA8, 0xB5, 0x5D, 0x0B, 0x0E}, {0xA0, 0xD3, 0x5D, 0x27, 0x0E},
+    {0x90, 0x28, 0x5E, 0x74, 0x0F}, {0x20, 0x05, 0x5F, 0x62, 0x11}, {0x00, 0xD8, 0x5E, 0x20, 0x11}, {0x28, 0x90, 0x5D, 0xB0, 0x0D},
+    {0x20, 0xE1, 0x5E, 0x2D, 0x11}, {0x30, 0xBE, 0x5C, 0x23, 0x0A}, {0x88, 0xDA, 0x5D, 0x31, 0x0E}, {0x90, 0x3D, 0x5D, 0x81, 0x0C},
+    {0x58, 0xDE, 0x5E, 0x29, 0x11}, {0x18, 0xD0, 0x5C, 0x7F, 0x0A}, {0xA8, 0xEE, 0x5E, 0x41, 0x11}, {0xB8, 0x6B, 0x5E, 0xBD, 0x0F},
+    {0xC0, 0xB0, 0x5D, 0x06, 0x0E}, {0xD8, 0xC7, 0x5E, 0x0A, 0x11}, {0x58, 0x54, 0x5D, 0xCC, 0x0C}, {0x58, 0x1B, 0x5D, 0x20, 0x0C},
+    {0x28, 0x74, 0x5D, 0x37, 0x0D}, {0xD0, 0xB5, 0x5C, 0x1A, 0x0A}, {0x68, 0x8A, 0x5D, 0xA8, 0x0D}, {0xD8, 0x7F, 0x5E, 0x35, 0x10},
+    {0xD0, 0x27, 0x5D, 0x63, 0x0C}, {0x70, 0xB1, 0x5D, 0x07, 0x0E}, {0xE8, 0x1D, 0x5D, 0x22, 0x0C}, {0x18, 0x26, 0x5E, 0x71, 0x0F},
+    {0x50, 0xC9, 0x5D, 0x1F, 0x0E}, {0x28, 0xE5, 0x5C, 0x3A, 0x0B}, {0xC8, 0xBD, 0x5E, 0xFC, 0x10}, {0x70, 0x6C, 0x5E, 0xBE, 0x0F},
+    {0x50, 0x3E, 0x5E, 0x8D, 0x0F}, {0x18, 0x8C, 0x5E, 0x83, 0x10}, {0xB0, 0x38, 0x5D, 0x79, 0x0C}, {0x48, 0xBA, 0x5E, 0xF7, 0x10},
+    {0x58, 0x25, 0x5E, 0x70, 0x0F}, {0x98, 0x4A, 0x5D, 0x91, 0x0C}, {0xE0, 0x6D, 0x5E, 0xC0, 0x0F}, {0xC0, 0xE7, 0x5C, 0x3F, 0x0B},
+    {0x30, 0x5C, 0x5E, 0xAD, 0x0F}, {0x78, 0xDB, 0x5C, 0xD8, 0x0A}, {0x78, 0xDB, 0x5E, 0x25, 0x11}, {0x98, 0xBF, 0x5D, 0x14, 0x0E},
+    {0x78, 0x35, 0x5D, 0x74, 0x0C}, {0xB8, 0x68, 0x5D, 0x2B, 0x0D}, {0xB0, 0xE6, 0x5C, 0x3D, 0x0B}, {0x60, 0x8F, 0x5D, 0xAF, 0x0D},
+    {0xA0, 0xE0, 0x5C, 0xDE, 0x0A}, {0xB0, 0x03, 0x5F, 0x60, 0x11}, {0x80, 0x5D, 0x5D, 0xDA, 0x0C}, {0x00, 0xD5, 0x5E, 0x1C, 0x11},
+    {0x18, 0xF6, 0x5E, 0x4F, 0x11}, {0x58, 0x20, 0x5E, 0x69, 0x0F}, {0x08, 0x03, 0x5D, 0xFF, 0x0B}, {0x48, 0x46, 0x5D, 0x8D, 0x0C},
+    {0x18, 0xDA, 0x5D, 0x30, 0x0E}, {0xF0, 0xC5, 0x5D, 0x1B, 0x0E}, {0x70, 0x25, 0x5D, 0x29, 0x0C}, {0x38, 0x55, 0x5D, 0xCD, 0x0C},
+    {0x20, 0x32, 0x5D, 0x70, 0x0C}, {0x78, 0xFB, 0x5D, 0x6D, 0x0E}, {0x50, 0x59, 0x5E, 0xAA, 0x0F}, {0xD8, 0xC8, 0x5C, 0x73, 0x0A},
+    {0xE0, 0x6A, 0x5E, 0xBC, 0x0F}, {0xB8, 0x44, 0x5E, 0x96, 0x0F}, {0xA0, 0x12, 0x5D, 0x13, 0x0C}, {0xD0, 0x35, 0x5E, 0x82, 0x0F},
+    {0x00, 0x98, 0x5E, 0x8F, 0x10}, {0xE8, 0xDC, 0x5E, 0x27, 0x11}, {0xF0, 0xD4, 0x5C, 0x85, 0x0A}, {0xC8, 0x6F, 0x5E, 0x20, 0x10},
+    {0x10, 0x48, 0x5D, 0x8E, 0x0C}, {0x30, 0xCB, 0x5C, 0x76, 0x0A}, {0x98, 0xB6, 0x5C, 0x1B, 0x0A}, {0xA8, 0x1A, 0x5D, 0x1F, 0x0C},
+    {0x00, 0x44, 0x5E, 0x95, 0x0F}, {0x60, 0x2A, 0x5D, 0x66, 0x0C}, {0x20, 0x71, 0x5E, 0x22, 0x10}, {0xE0, 0x8E, 0x5E, 0x86, 0x10},
+    {0x30, 0xB7, 0x5C, 0x1C, 0x0A}, {0xA8, 0xD5, 0x5C, 0x86, 0x0A}, {0x48, 0x0C, 0x5E, 0x88, 0x0E}, {0x20, 0xCE, 0x5C, 0x7B, 0x0A},
+    {0x38, 0x87, 0x5D, 0xA3, 0x0D}, {0x20, 0x46, 0x5E, 0x98, 0x0F}, {0xC0, 0x87, 0x5D, 0xA4, 0x0D}, {0x20, 0xE7, 0x5C, 0x3E, 0x0B},
+    {0x28, 0xF2, 0x5D, 0x60, 0x0E}, {0x58, 0xB2, 0x5E, 0xEC, 0x10}, {0x98, 0x72, 0x5E, 0x24, 0x10}, {0x18, 0xD1, 0x5E, 0x17, 0x11},
+    {0xD0, 0x92, 0x5D, 0xB4, 0x0D}, {0x48, 0x09, 0x5E, 0x83, 0x0E}, {0x60, 0x6F, 0x5D, 0x34, 0x0D}, {0x88, 0x91, 0x5D, 0xB2, 0x0D},
+    {0xC8, 0x33, 0x5D, 0x72, 0x0C}, {0x80, 0x61, 0x5E, 0xAE, 0x0F}, {0x30, 0xEC, 0x5C, 0x46, 0x0B}, {0x30, 0x34, 0x5E, 0x80, 0x0F},
+    {0xC8, 0x89, 0x5E, 0x40, 0x10}, {0x18, 0x6A, 0x5E, 0xBB, 0x0F}, {0x90, 0xA7, 0x5E, 0x9E, 0x10}, {0xF8, 0xFD, 0x5E, 0x58, 0x11},
+    {0x90, 0x83, 0x5D, 0x9E, 0x0D}, {0xB8, 0x27, 0x5E, 0x73, 0x0F}, {0xD8, 0x78, 0x5D, 0x92, 0x0D}, {0x98, 0xE2, 0x5E, 0x2F, 0x11},
+    {0x28, 0x3B, 0x5D, 0x7D, 0x0C}, {0x20, 0x21, 0x5E, 0x6A, 0x0F}, {0xD0, 0xAF, 0x5C, 0x10, 0x0A}, {0x18, 0x7A, 0x5D, 0x94, 0x0D},
+    {0x28, 0x58, 0x5E, 0xA9, 0x0F}, {0xA0, 0x45, 0x5D, 0x8C, 0x0C}, {0x58, 0x73, 0x5E, 0x25, 0x10}, {0x20, 0x04, 0x5D, 0x00, 0x0C},
+    {0x48, 0x89, 0x5D, 0xA6, 0x0D}, {0x68, 0xE0, 0x5E, 0x2C, 0x11}, {0x68, 0x13, 0x5D, 0x14, 0x0C}, {0xA8, 0x65, 0x5E, 0xB4, 0x0F},
+    {0x30, 0x06, 0x5E, 0x7E, 0x0E}, {0x48, 0x0E, 0x5D, 0x0D, 0x0C}, {0x80, 0x3F, 0x5D, 0x84, 0x0C}, {0x08, 0x5C, 0x5D, 0xD7, 0x0C},
+    {0x00, 0x78, 0x5E, 0x2B, 0x10}, {0x70, 0x13, 0x5E, 0x58, 0x0F}, {0xD0, 0x64, 0x5D, 0xE4, 0x0C}, {0x60, 0xBD, 0x5C, 0x22, 0x0A},
+    {0xD8, 0x16, 0x5D, 0x1A, 0x0C}, {0x38, 0xE5, 0x5D, 0x3B, 0x0E}, {0x98, 0x7F, 0x5D, 0x9A, 0x0D}, {0x08, 0x1A, 0x5E, 0x5E, 0x0F},
+    {0x10, 0x29, 0x5D, 0x64, 0x0C}, {0x90, 0xF2, 0x5D, 0x61, 0x0E}, {0xC8, 0xD5, 0x5E, 0x1D, 0x11}, {0x90, 0x08, 0x5E, 0x82, 0x0E},
+    {0x50, 0xE3, 0x5D, 0x3A, 0x0E}, {0xC8, 0x2C, 0x5D, 0x69, 0x0C}, {0xB8, 0xFC, 0x5D, 0x6F, 0x0E}, {0xF8, 0x44, 0x5D, 0x8B, 0x0C},
+    {0x58, 0xEA, 0x5E, 0x3B, 0x11}, {0x50, 0x24, 0x5D, 0x28, 0x0C}, {0xE8, 0x21, 0x5E, 0x6B, 0x0F}, {0x70, 0xFE, 0x5C, 0x9E, 0x0B},
+    {0x50, 0x39, 0x5E, 0x86, 0x0F}, {0xD8, 0xE1, 0x5E, 0x2E, 0x11}, {0xC8, 0x3B, 0x5D, 0x7E, 0x0C}, {0x10, 0xE6, 0x5C, 0x3C, 0x0B},
+    {0xA8, 0x7D, 0x5E, 0x32, 0x10}, {0xB8, 0x53, 0x5D, 0xCB, 0x0C}, {0x50, 0xD2, 0x5D, 0x25, 0x0E}, {0x98, 0xBA, 0x5C, 0x20, 0x0A},
+    {0xE8, 0xDF, 0x5C, 0xDD, 0x0A}, {0x00, 0x95, 0x5D, 0xF3, 0x0D}, {0x80, 0xAC, 0x5C, 0x0D, 0x0A}, {0xE0, 0x59, 0x5D, 0xD4, 0x0C},
+    {0x58, 0xA4, 0x5E, 0x9B, 0x10}, {0xD0, 0x4C, 0x5D, 0x94, 0x0C}, {0xF0, 0x7C, 0x5E, 0x31, 0x10}, {0xC8, 0xC1, 0x5D, 0x16, 0x0E},
+    {0x28, 0xDF, 0x5C, 0xDC, 0x0A}, {0x10, 0xF5, 0x5E, 0x4A, 0x11}, {0x08, 0xEE, 0x5E, 0x40, 0x11}, {0xD0, 0xCC, 0x5E, 0x11, 0x11},
+    {0xB0, 0xC9, 0x5C, 0x74, 0x0A}, {0xA8, 0xB7, 0x5C, 0x1D, 0x0A}, {0xF0, 0x8D, 0x5E, 0x85, 0x10}, {0x98, 0x8B, 0x5D, 0xAA, 0x0D},
+    {0xA8, 0x12, 0x5E, 0x57, 0x0F}, {0xA0, 0xC8, 0x5E, 0x0B, 0x11}, {0x48, 0x62, 0x5E, 0xAF, 0x0F}, {0x08, 0x26, 0x5D, 0x2A, 0x0C},
+    {0x50, 0xE3, 0x5E, 0x30, 0x11}, {0x70, 0x19, 0x5E, 0x5D, 0x0F}, {0xE0, 0xCE, 0x5C, 0x7D, 0x0A}, {0x68, 0xC5, 0x5D, 0x1A, 0x0E},
+    {0x58, 0x3C, 0x5D, 0x7F, 0x0C}, {0x50, 0x44, 0x5D, 0x8A, 0x0C}, {0xA0, 0xA8, 0x5E, 0x9F, 0x10}, {0x28, 0xBF, 0x5C, 0x24, 0x0A},
+    {0x70, 0x87, 0x5E, 0x3F, 0x10}, {0xA8, 0xC6, 0x5C, 0x71, 0x0A}, {0xC0, 0x06, 0x5E, 0x7F, 0x0E}, {0x98, 0x84, 0x5E, 0x3B, 0x10},
+    {0xC0, 0x30, 0x5D, 0x6E, 0x0C}, {0x18, 0x9B, 0x5E, 0x92, 0x10}, {0xE0, 0x3C, 0x5E, 0x8B, 0x0F}, {0x30, 0xEB, 0x5D, 0x58, 0x0E},
+    {0xF8, 0xD0, 0x5D, 0x24, 0x0E}, {0x98, 0xF3, 0x5E, 0x48, 0x11}, {0x48, 0xF4, 0x5D, 0x64, 0x0E}, {0x40, 0xB4, 0x5C, 0x17, 0x0A},
+    {0x60, 0xDE, 0x5C, 0xDB, 0x0A}, {0x00, 0xF0, 0x5E, 0x43, 0x11}, {0x30, 0x67, 0x5D, 0xE7, 0x0C}, {0x50, 0xC9, 0x5E, 0x0C, 0x11},
+    {0xB0, 0x03, 0x5E, 0x7A, 0x0E}, {0xA0, 0x3D, 0x5E, 0x8C, 0x0F}, {0x40, 0xE1, 0x5C, 0xDF, 0x0A}, {0xC0, 0x85, 0x5D, 0xA1, 0x0D},
+    {0xD8, 0x8F, 0x5E, 0x87, 0x10}, {0xC8, 0x57, 0x5D, 0xD1, 0x0C}, {0x08, 0x6F, 0x5E, 0x1F, 0x10}, {0x58, 0xFD, 0x5D, 0x70, 0x0E},
+    {0x68, 0x83, 0x5E, 0x3A, 0x10}, {0x08, 0x51, 0x5D, 0xC7, 0x0C}, {0x58, 0x7B, 0x5D, 0x96, 0x0D}, {0xD8, 0x8D, 0x5D, 0xAD, 0x0D},
+    {0xA8, 0x98, 0x5D, 0xF4, 0x0D}, {0xA0, 0x1C, 0x5D, 0x21, 0x0C}, {0xE8, 0xB2, 0x5C, 0x15, 0x0A}, {0xD0, 0xD0, 0x5C, 0x80, 0x0A},
+    {0x30, 0x3C, 0x5E, 0x8A, 0x0F}, {0xB8, 0x49, 0x5E, 0x9D, 0x0F}, {0xE0, 0xC0, 0x5C, 0x26, 0x0A}, {0x80, 0x66, 0x5D, 0xE6, 0x0C},
+    {0x80, 0xC1, 0x5E, 0x01, 0x11}, {0x48, 0xB9, 0x5D, 0x10, 0x0E}, {0x68, 0x11, 0x5D, 0x12, 0x0C}, {0x30, 0xB6, 0x5D, 0x0C, 0x0E},
+    {0x18, 0x35, 0x5E, 0x81, 0x0F}, {0x70, 0xB7, 0x5E, 0xF3, 0x10}, {0xB0, 0xF8, 0x5D, 0x68, 0x0E}, {0xC0, 0x3A, 0x5E, 0x88, 0x0F},
+    {0x18, 0xD4, 0x5E, 0x1B, 0x11}, {0xB8, 0x0C, 0x5E, 0x89, 0x0E}, {0xE0, 0x29, 0x5D, 0x65, 0x0C}, {0xB8, 0xF4, 0x5D, 0x65, 0x0E},
+    {0x58, 0xA2, 0x5E, 0x99, 0x10}, {0x48, 0x23, 0x5E, 0x6D, 0x0F}, {0xF0, 0x52, 0x5D, 0xCA, 0x0C}, {0x50, 0x43, 0x5E, 0x94, 0x0F},
+    {0x58, 0x5B, 0x5D, 0xD6, 0x0C}, {0x88, 0xBE, 0x5E, 0xFD, 0x10}, {0x28, 0x6D, 0x5E, 0xBF, 0x0F}, {0x38, 0x15, 0x5D, 0x17, 0x0C},
+    {0xB8, 0x65, 0x5D, 0xE5, 0x0C}, {0x30, 0xE9, 0x5E, 0x3A, 0x11}, {0x68, 0xC4, 0x5C, 0x6F, 0x0A}, {0xC0, 0xE5, 0x5E, 0x37, 0x11},
+    {0x48, 0x64, 0x5D, 0xE3, 0x0C}, {0x68, 0x11, 0x5E, 0x90, 0x0E}, {0x30, 0x52, 0x5D, 0xC9, 0x0C}, {0x08, 0x4E, 0x5E, 0xA3, 0x0F},
+    {0x88, 0x69, 0x5E, 0xBA, 0x0F}, {0xB0, 0x41, 0x5D, 0x88, 0x0C}, {0x10, 0xF7, 0x5E, 0x50, 0x11}, {0x18, 0xB3, 0x5E, 0xED, 0x10},
+    {0x98, 0x34, 0x5D, 0x73, 0x0C}, {0x88, 0xEC, 0x5E, 0x3E, 0x11}, {0x48, 0xE0, 0x5D, 0x37, 0x0E}, {0xF0, 0x7B, 0x5D, 0x97, 0x0D},
+    {0x80, 0x88, 0x5D, 0xA5, 0x0D}, {0x20, 0x16, 0x5D, 0x19, 0x0C}, {0x40, 0xD9, 0x5C, 0xD5, 0x0A}, {0xF0, 0x9E, 0x5E, 0x96, 0x10},
+    {0x68, 0x40, 0x5E, 0x90, 0x0F}, {0xD0, 0x80, 0x5D, 0x9B, 0x0D}, {0xA0, 0xFB, 0x5C, 0x51, 0x0B}, {0x88, 0x01, 0x5F, 0x5D, 0x11},
+    {0x70, 0x8E, 0x5D, 0xAE, 0x0D}, {0xB8, 0xFD, 0x5C, 0x9D, 0x0B}, {0xC0, 0x07, 0x5D, 0x04, 0x0C}, {0xA0, 0x42, 0x5E, 0x93, 0x0F},
+    {0xF0, 0x82, 0x5D, 0x9D, 0x0D}, {0xC0, 0xDA, 0x5C, 0xD7, 0x0A}, {0xF0, 0x72, 0x5D, 0x36, 0x0D}, {0xB8, 0xB6, 0x5D, 0x0D, 0x0E},
+    {0x28, 0xF2, 0x5E, 0x46, 0x11}, {0x70, 0x37, 0x5E, 0x84, 0x0F}, {0x18, 0xC7, 0x5D, 0x1D, 0x0E}, {0xF8, 0xC9, 0x5E, 0x0D, 0x11},
+    {0x08, 0xD7, 0x5C, 0x88, 0x0A}, {0x20, 0xB0, 0x5E, 0xE9, 0x10}, {0xC0, 0xF0, 0x5E, 0x44, 0x11}, {0x40, 0xB7, 0x5D, 0x0E, 0x0E},
+    {0x90, 0xBD, 0x5D, 0x13, 0x0E}, {0x30, 0x2C, 0x5D, 0x68, 0x0C}, {0xD0, 0x0B, 0x5E, 0x87, 0x0E}, {0x58, 0x4D, 0x5E, 0xA2, 0x0F},
+    {0x70, 0xC6, 0x5E, 0x08, 0x11}, {0xF0, 0x0F, 0x5E, 0x8D, 0x0E}, {0x48, 0xB8, 0x5C, 0x1E, 0x0A}, {0x88, 0xD1, 0x5C, 0x81, 0x0A},
+    {0xC0, 0xBB, 0x5D, 0x11, 0x0E}, {0xD0, 0xAF, 0x5D, 0x05, 0x0E}, {0x88, 0x07, 0x5E, 0x80, 0x0E}, {0x48, 0x18, 0x5D, 0x1C, 0x0C},
+    {0xF0, 0x54, 0x5E, 0xA7, 0x0F}, {0xE0, 0xF2, 0x5E, 0x47, 0x11}, {0x30, 0x0F, 0x5E, 0x8C, 0x0E}, {0xB0, 0x86, 0x5E, 0x3E, 0x10},
+    {0x40, 0x21, 0x5D, 0x24, 0x0C}, {0xD0, 0xEB, 0x5E, 0x3D, 0x11}, {0x88, 0x61, 0x5D, 0xE0, 0x0C}, {0x80, 0x31, 0x5D, 0x6F, 0x0C},
+    {0xF0, 0x68, 0x5E, 0xB9, 0x0F}, {0x70, 0xF1, 0x5E, 0x45, 0x11}, {0x20, 0xCC, 0x5E, 0x10, 0x11}, {0xD8, 0xEE, 0x5D, 0x5B, 0x0E},
+    {0x00, 0xDA, 0x5C, 0xD6, 0x0A}, {0x58, 0x3E, 0x5D, 0x82, 0x0C}, {0x98, 0xBC, 0x5D, 0x12, 0x0E}, {0x50, 0x19, 0x5D, 0x1D, 0x0C},
+    {0x10, 0x9C, 0x5E, 0x93, 0x10}, {0xE0, 0x36, 0x5D, 0x76, 0x0C}, {0x18, 0x4F, 0x5D, 0x97, 0x0C}, {0x18, 0xC4, 0x5D, 0x18, 0x0E},
+    {0xC0, 0x26, 0x5D, 0x2B, 0x0C}, {0x88, 0xE9, 0x5C, 0x42, 0x0B}, {0x78, 0xD5, 0x5D, 0x28, 0x0E}, {0x90, 0xAA, 0x5E, 0xA1, 0x10},
+    {0xC8, 0x60, 0x5D, 0xDF, 0x0C}, {0x80, 0xD8, 0x5C, 0xD4, 0x0A}, {0x30, 0xDC, 0x5E, 0x26, 0x11}, {0x58, 0x04, 0x5D, 0x01, 0x0C},
+    {0xB0, 0x2E, 0x5D, 0x6B, 0x0C}, {0x88, 0xCD, 0x5E, 0x12, 0x11}, {0x50, 0x6A, 0x5D, 0x2D, 0x0D}, {0xC8, 0x93, 0x5E, 0x8B, 0x10},
+    {0x70, 0x4D, 0x5D, 0x95, 0x0C}, {0x90, 0xCE, 0x5C, 0x7C, 0x0A}, {0x30, 0xAE, 0x5E, 0xE7, 0x10}, {0x18, 0x65, 0x5E, 0xB3, 0x0F},
+    {0x78, 0x3B, 0x5E, 0x89, 0x0F}, {0x60, 0xD7, 0x5D, 0x2B, 0x0E}, {0x68, 0x29, 0x5E, 0x75, 0x0F}, {0xB0, 0x82, 0x5E, 0x39, 0x10},
+    {0x28, 0x7D, 0x5D, 0x98, 0x0D}, {0x40, 0xB5, 0x5E, 0xF0, 0x10}, {0x08, 0x2E, 0x5D, 0x6A, 0x0C}, {0x18, 0xEB, 0x5E, 0x3C, 0x11},
+    {0xC0, 0x39, 0x5D, 0x7B, 0x0C}, {0xF8, 0x62, 0x5E, 0xB0, 0x0F}, {0xC0, 0x10, 0x5D, 0x11, 0x0C}, {0xD0, 0x9D, 0x5D, 0xF7, 0x0D},
+    {0x20, 0x60, 0x5D, 0xDE, 0x0C}, {0x08, 0xDF, 0x5E, 0x2A, 0x11}, {0xC0, 0xDA, 0x5E, 0x24, 0x11}, {0x30, 0xAD, 0x5E, 0xA2, 0x10},
+    {0x78, 0x50, 0x5D, 0x98, 0x0C}, {0xA8, 0xCA, 0x5E, 0x0E, 0x11}, {0x30, 0xC2, 0x5C, 0x27, 0x0A}, {0x78, 0x09, 0x5D, 0x07, 0x0C},
+    {0xC0, 0x05, 0x5E, 0x7D, 0x0E}, {0x38, 0x4C, 0x5D, 0x93, 0x0C}, {0x78, 0xB2, 0x5C, 0x14, 0x0A}, {0xF8, 0x85, 0x5E, 0x3D, 0x10},
+    {0x68, 0x04, 0x5F, 0x61, 0x11}, {0xC8, 0x91, 0x5E, 0x89, 0x10}, {0xC0, 0x0D, 0x5D, 0x0C, 0x0C}, {0x00, 0x03, 0x5F, 0x5F, 0x11},
+    {0xD8, 0x5E, 0x5D, 0xDC, 0x0C}, {0xE0, 0xF3, 0x5D, 0x63, 0x0E}, {0x68, 0x0A, 0x5E, 0x85, 0x0E}, {0x90, 0x2F, 0x5E, 0x7C, 0x0F},
+    {0x78, 0x79, 0x5D, 0x93, 0x0D}, {0xD8, 0xC3, 0x5C, 0x2A, 0x0A}, {0x30, 0xE2, 0x5D, 0x39, 0x0E}, {0x98, 0x2E, 0x5E, 0x7B, 0x0F},
+    {0xF0, 0xE8, 0x5C, 0x41, 0x0B}, {0xE0, 0x19, 0x5D, 0x1E, 0x0C}, {0xA0, 0x31, 0x5E, 0x7E, 0x0F}, {0x70, 0x8C, 0x5D, 0xAB, 0x0D},
+    {0xE0, 0x89, 0x5D, 0xA7, 0x0D}, {0x08, 0xF1, 0x5D, 0x5E, 0x0E}, {0xD8, 0xB8, 0x5E, 0xF5, 0x10}, {0x30, 0x84, 0x5D, 0x9F, 0x0D},
+    {0xC8, 0xB8, 0x5C, 0x1F, 0x0A}, {0x30, 0x1F, 0x5D, 0x23, 0x0C}, {0x20, 0x9F, 0x5D, 0xF8, 0x0D}, {0x50, 0x86, 0x5D, 0xA2, 0x0D},
+    {0xD0, 0x01, 0x5E, 0x77, 0x0E}, {0xF0, 0x52, 0x5E, 0xA6, 0x0F}, {0x90, 0xB3, 0x5C, 0x16, 0x0A}, {0x08, 0x9D, 0x5E, 0x94, 0x10},
+    {0x88, 0x49, 0x5D, 0x90, 0x0C}, {0xB8, 0x4E, 0x5E, 0xA4, 0x0F}, {0xC8, 0x6B, 0x5D, 0x2F, 0x0D}, {0x78, 0x70, 0x5E, 0x21, 0x10},
+    {0x60, 0x7E, 0x5D, 0x99, 0x0D}, {0x38, 0xFD, 0x5E, 0x57, 0x11}, {0x00, 0xFE, 0x5D, 0x71, 0x0E}, {0xD8, 0x75, 0x5E, 0x28, 0x10},
+    {0x80, 0xCF, 0x5C, 0x7E, 0x0A}, {0x10, 0x6B, 0x5D, 0x2E, 0x0D}, {0xB0, 0xFA, 0x5C, 0x50, 0x0B}, {0x20, 0x41, 0x5E, 0x91, 0x0F},
+    {0x00, 0x3F, 0x5E, 0x8E, 0x0F}, {0xC0, 0xD3, 0x5C, 0x84, 0x0A}, {0xC0, 0x92, 0x5E, 0x8A, 0x10}, {0xE8, 0x32, 0x5E, 0x7F, 0x0F},
+    {0xF0, 0x2D, 0x5E, 0x7A, 0x0F}, {0xD0, 0xF2, 0x5C, 0x49, 0x0B}, {0x48, 0x77, 0x5E, 0x2A, 0x10}, {0x38, 0xFA, 0x5D, 0x6A, 0x0E},
+    {0xB8, 0xDF, 0x5E, 0x2B, 0x11}, {0xF8, 0xF9, 0x5C, 0x4F, 0x0B}, {0x78, 0x63, 0x5D, 0xE2, 0x0C}, {0x28, 0xFB, 0x5D, 0x6B, 0x0E},
+    {0x40, 0xE8, 0x5C, 0x40, 0x0B}, {0xE0, 0xB4, 0x5D, 0x0A, 0x0E}, {0x60, 0x08, 0x5D, 0x05, 0x0C}, {0x38, 0xDC, 0x5C, 0xD9, 0x0A},
+    {0x10, 0x2B, 0x5D, 0x67, 0x0C}, {0x48, 0x62, 0x5D, 0xE1, 0x0C}, {0x40, 0x02, 0x5F, 0x5E, 0x11}, {0x00, 0xC0, 0x5E, 0xFF, 0x10},
+    {0x10, 0xFA, 0x5E, 0x53, 0x11}, {0xB0, 0xB6, 0x5E, 0xF2, 0x10}, {0x68, 0xCB, 0x5E, 0x0F, 0x11}, {0xA0, 0xDD, 0x5E, 0x28, 0x11},
+    {0xD0, 0x00, 0x5F, 0x5C, 0x11}, {0x80, 0xE9, 0x5D, 0x57, 0x0E}, {0x08, 0x74, 0x5E, 0x26, 0x10}, {0x30, 0x00, 0x5D, 0xA0, 0x0B},
+    {0xF8, 0x67, 0x5D, 0xE8, 0x0C}, {0x68, 0x68, 0x5E, 0xB8, 0x0F}, {0x80, 0xFC, 0x5C, 0x9B, 0x0B}, {0x68, 0xAE, 0x5D, 0x04, 0x0E},
+    {0x40, 0xBF, 0x5E, 0xFE, 0x10}, {0x70, 0xCC, 0x5D, 0x21, 0x0E}, {0x78, 0xF1, 0x5D, 0x5F, 0x0E}, {0x18, 0xFD, 0x5C, 0x9C, 0x0B},
+    {0x20, 0x9A, 0x5E, 0x91, 0x10}, {0xC8, 0xC0, 0x5E, 0x00, 0x11}, {0x30, 0xC2, 0x5E, 0x02, 0x11}, {0x40, 0x10, 0x5D, 0x10, 0x0C},
+    {0xF8, 0x94, 0x5E, 0x8C, 0x10}, {0x90, 0x80, 0x5E, 0x36, 0x10}, {0xE8, 0xDB, 0x5D, 0x33, 0x0E}, {0xD8, 0xB3, 0x5E, 0xEE, 0x10},
+    {0x58, 0x2F, 0x5D, 0x6C, 0x0C}, {0xE8, 0x67, 0x5E, 0xB7, 0x0F}, {0x48, 0xC8, 0x5C, 0x72, 0x0A}, {0x10, 0xF9, 0x5E, 0x52, 0x11},
+    {0x30, 0xF0, 0x5D, 0x5D, 0x0E}, {0xE8, 0x90, 0x5E, 0x88, 0x10}, {0xC0, 0x6C, 0x5D, 0x30, 0x0D}, {0xD8, 0x71, 0x5E, 0x23, 0x10},
+    {0x88, 0x36, 0x5E, 0x83, 0x0F}, {0x90, 0x3A, 0x5D, 0x7C, 0x0C}, {0xF0, 0x32, 0x5D, 0x71, 0x0C}, {0x70, 0xFF, 0x5C, 0x9F, 0x0B},
+    {0x10, 0xCE, 0x5D, 0x22, 0x0E}, {0x40, 0xEB, 0x5C, 0x45, 0x0B}, {0x48, 0xA1, 0x5E, 0x98, 0x10}, {0x10, 0xD3, 0x5C, 0x83, 0x0A},
+    {0x38, 0x6D, 0x5D, 0x31, 0x0D}, {0x00, 0x38, 0x5D, 0x78, 0x0C}, {0x18, 0xAD, 0x5D, 0x02, 0x0E}, {0xA8, 0xE7, 0x5D, 0x3D, 0x0E},
+    {0x70, 0x37, 0x5D, 0x77, 0x0C}, {0x60, 0xCA, 0x5C, 0x75, 0x0A}, {0x58, 0x0C, 0x5D, 0x0A, 0x0C}, {0xD8, 0x40, 0x5D, 0x86, 0x0C},
+    {0xF8, 0xD7, 0x5D, 0x2C, 0x0E}, {0xE8, 0x96, 0x5E, 0x8E, 0x10}, {0xD8, 0xE4, 0x5C, 0x39, 0x0B}, {0xF8, 0xBF, 0x5C, 0x25, 0x0A},
+    {0x90, 0x55, 0x5D, 0xCE, 0x0C}, {0x88, 0x5C, 0x5D, 0xD8, 0x0C}, {0xC8, 0xB8, 0x5D, 0x0F, 0x0E}, {0x18, 0x19, 0x5E, 0x5C, 0x0F},
+    {0x60, 0xDD, 0x5C, 0xDA, 0x0A}, {0x78, 0x4F, 0x5E, 0xA5, 0x0F}, {0xA8, 0xDE, 0x5D, 0x35, 0x0E}, {0x98, 0xB1, 0x5E, 0xEB, 0x10},
+    {0x30, 0xF5, 0x5D, 0x66, 0x0E}, {0x00, 0x82, 0x5E, 0x38, 0x10}, {0xD8, 0xB0, 0x5E, 0xEA, 0x10}, {0xB8, 0xA5, 0x5D, 0xFD, 0x0D},
+    {0x30, 0xD3, 0x5E, 0x1A, 0x11}, {0x18, 0x22, 0x5D, 0x25, 0x0C}, {0x10, 0xF6, 0x5C, 0x4B, 0x0B}, {0xD8, 0x30, 0x5E, 0x7D, 0x0F},
+    {0x00, 0x9E, 0x5E, 0x95, 0x10}, {0x90, 0xA6, 0x5E, 0x9D, 0x10}, {0xD0, 0xD1, 0x5E, 0x18, 0x11}, {0xF8, 0x3E, 0x5D, 0x83, 0x0C},
+    {0x08, 0x57, 0x5D, 0xD0, 0x0C}, {0xA8, 0x22, 0x5D, 0x26, 0x0C}, {0x68, 0x9C, 0x5D, 0xF6, 0x0D}, {0xA8, 0x75, 0x5D, 0x8F, 0x0D},
+    {0x98, 0x06, 0x5D, 0x03, 0x0C}, {0x80, 0x66, 0x5E, 0xB5, 0x0F}, {0xA8, 0xE1, 0x5C, 0xE0, 0x0A}, {0x10, 0x2B, 0x5E, 0x76, 0x0F},
+    {0x38, 0x0D, 0x5D, 0x0B, 0x0C}, {0x50, 0x15, 0x5E, 0x59, 0x0F}, {0xF0, 0x00, 0x5D, 0xA1, 0x0B}, {0xA0, 0xCB, 0x5C, 0x77, 0x0A},
+    {0x90, 0xF7, 0x5C, 0x4C, 0x0B}, {0x40, 0xD6, 0x5D, 0x29, 0x0E}, {0x60, 0x2C, 0x5E, 0x78, 0x0F}, {0xC0, 0xC7, 0x5D, 0x1E, 0x0E},
+    {0x68, 0xBC, 0x5E, 0xFA, 0x10}, {0x80, 0xAB, 0x5D, 0x01, 0x0E}, {0xE8, 0xC2, 0x5C, 0x28, 0x0A}, {0x00, 0x94, 0x5D, 0xB6, 0x0D},
+    {0x40, 0x11, 0x5E, 0x8F, 0x0E}, {0x78, 0x4A, 0x5E, 0x9E, 0x0F}, {0x80, 0xC2, 0x5D, 0x17, 0x0E}, {0x48, 0x81, 0x5E, 0x37, 0x10},
+    {0x28, 0xA1, 0x5D, 0xF9, 0x0D}, {0x20, 0x3D, 0x5D, 0x80, 0x0C}, {0x88, 0xD9, 0x5D, 0x2F, 0x0E}, {0x78, 0xAD, 0x5C, 0x0E, 0x0A},
+    {0xF8, 0xB5, 0x5E, 0xF1, 0x10}, {0x70, 0x02, 0x5D, 0xA3, 0x0B}, {0xF8, 0xC5, 0x5C, 0x70, 0x0A}, {0x50, 0xD6, 0x5C, 0x87, 0x0A},
+    {0x30, 0xCA, 0x5D, 0x20, 0x0E}, {0xF8, 0xF7, 0x5D, 0x67, 0x0E}, {0x30, 0xDD, 0x5D, 0x34, 0x0E}, {0x50, 0xAA, 0x5D, 0x00, 0x0E},
+    {0xE0, 0x41, 0x5E, 0x92, 0x0F}, {0x08, 0xBB, 0x5E, 0xF8, 0x10}, {0x68, 0xB0, 0x5C, 0x11, 0x0A}, {0x58, 0x48, 0x5E, 0x9B, 0x0F},
+    {0xC8, 0xBC, 0x5C, 0x21, 0x0A}, {0x28, 0xB8, 0x5E, 0xF4, 0x10}, {0xC0, 0xA1, 0x5D, 0xFA, 0x0D}, {0x40, 0x0F, 0x5D, 0x0E, 0x0C},
+    {0xC0, 0x04, 0x5E, 0x7C, 0x0E}, {0xE8, 0x4B, 0x5E, 0xA0, 0x0F}, {0x70, 0xA9, 0x5E, 0xA0, 0x10}, {0x98, 0x15, 0x5D, 0x18, 0x0C},
+    {0x28, 0x59, 0x5D, 0xD3, 0x0C}, {0x38, 0x41, 0x5D, 0x87, 0x0C}, {0xC8, 0xED, 0x5D, 0x5A, 0x0E}, {0xA0, 0x10, 0x5E, 0x8E, 0x0E},
+    {0xC0, 0x1E, 0x5E, 0x67, 0x0F}, {0x18, 0xD9, 0x5D, 0x2E, 0x0E}, {0x50, 0xB5, 0x5C, 0x19, 0x0A}, {0x80, 0x5B, 0x5E, 0xAC, 0x0F},
+    {0x48, 0xF3, 0x5D, 0x62, 0x0E}, {0x50, 0x93, 0x5D, 0xB5, 0x0D}, {0x38, 0x40, 0x5D, 0x85, 0x0C}, {0x80, 0xD2, 0x5E, 0x19, 0x11},
+    {0x98, 0x63, 0x5E, 0xB1, 0x0F}, {0xD0, 0x23, 0x5E, 0x6E, 0x0F}, {0x18, 0xE3, 0x5C, 0xE2, 0x0A}, {0xB0, 0xAD, 0x5D, 0x03, 0x0E},
+    {0x18, 0x14, 0x5D, 0x15, 0x0C}, {0xF0, 0x90, 0x5D, 0xB1, 0x0D}, {0x90, 0x23, 0x5D, 0x27, 0x0C}, {0x50, 0x1A, 0x5E, 0x64, 0x0F},
+    {0x10, 0x08, 0x5E, 0x81, 0x0E}, {0x98, 0xC3, 0x5E, 0x04, 0x11}, {0x18, 0xE8, 0x5E, 0x39, 0x11}, {0xC0, 0x6E, 0x5D, 0x33, 0x0D},
+    {0xB8, 0xD7, 0x5C, 0xD3, 0x0A}, {0x68, 0x9B, 0x5D, 0xF5, 0x0D}, {0x78, 0x1F, 0x5E, 0x68, 0x0F}, {0x48, 0xED, 0x5E, 0x3F, 0x11},
+    {0xA0, 0x11, 0x5E, 0x91, 0x0E}, {0x10, 0xDA, 0x5E, 0x23, 0x11}, {0xE0, 0xB2, 0x5D, 0x08, 0x0E}, {0x28, 0x00, 0x5F, 0x5B, 0x11},
+    {0x90, 0x76, 0x5E, 0x29, 0x10}, {0xA0, 0x24, 0x5E, 0x6F, 0x0F}, {0x40, 0xCE, 0x5E, 0x13, 0x11}, {0x70, 0xCC, 0x5C, 0x78, 0x0A},
+    {0xB0, 0x3F, 0x5E, 0x8F, 0x0F}, {0x10, 0x1E, 0x5E, 0x66, 0x0F}, {0x70, 0xA7, 0x5D, 0xFF, 0x0D}, {0xF0, 0xF0, 0x5C, 0x48, 0x0B},
+    {0xB8, 0x0F, 0x5D, 0x0F, 0x0C}, {0x30, 0xAF, 0x5C, 0x0F, 0x0A}, {0x08, 0x2D, 0x5E, 0x79, 0x0F}, {0xB8, 0x00, 0x5E, 0x75, 0x0E},
+    {0xB8, 0xD8, 0x5E, 0x21, 0x11}, {0x08, 0x09, 0x5D, 0x06, 0x0C}, {0xF8, 0x6D, 0x5D, 0x32, 0x0D}, {0xF8, 0x26, 0x5E, 0x72, 0x0F},
+    {0x60, 0x7E, 0x5E, 0x33, 0x10}, {0x40, 0xD7, 0x5E, 0x1F, 0x11}, {0x50, 0x43, 0x5D, 0x89, 0x0C}, {0x28, 0x8D, 0x5D, 0xAC, 0x0D},
+};
+
+const DIC_HASH diagHash = {
+    .displace = diagDisplace,
+    .entries = diagEntries,
+    .buckets = 178,
+    .size = 712,
+};
+
+static const uint16_t quizDisplace[43] = {
+    8, 27, 173, 2, 10, 39, 129, 1, 0, 0, 8, 20, 0, 148, 1, 29,
+    137, 293, 326, 41, 210, 63, 19, 79, 5, 349, 0, 38, 34, 23, 5, 59,
+    156, 27, 192, 711, 94, 1, 4, 638, 1626, 590, 117,
+};
+
+static const uint8_t quizEntries[170][5] = {
+    {0xA0, 0xAF, 0x5F, 0xC5, 0x13}, {0x20, 0xB3, 0x5F, 0xC8, 0x13}, {0x20, 0x43, 0x5F, 0x45, 0x12}, {0x80, 0xB5, 0x5F, 0xCA, 0x13},
+    {0x88, 0xB7, 0x5F, 0xCC, 0x13}, {0x80, 0x4C, 0x5F, 0x4E, 0x12}, {0xA0, 0xA6, 0x5F, 0xBD, 0x13}, {0x90, 0xBA, 0x5F, 0xCF, 0x13},
+    {0x28, 0x2E, 0x5F, 0x31, 0x12}, {0x70, 0x18, 0x5F, 0x1B, 0x12}, {0x20, 0x6C, 0x5F, 0x6C, 0x12}, {0x70, 0x35, 0x5F, 0x38, 0x12},
+    {0x88, 0x88, 0x5F, 0xEC, 0x12}, {0xB0, 0x3B, 0x5F, 0x3E, 0x12}, {0x80, 0x2A, 0x5F, 0x2D, 0x12}, {0xA8, 0x5F, 0x5F, 0x61, 0x12},
+    {0x10, 0x40, 0x5F, 0x42, 0x12}, {0x10, 0x14, 0x5F, 0x16, 0x12}, {0x88, 0x94, 0x5F, 0xAD, 0x13}, {0x38, 0x9A, 0x5F, 0xB2, 0x13},
+    {0x70, 0x6D, 0x5F, 0x6D, 0x12}, {0x18, 0x21, 0x5F, 0x24, 0x12}, {0x08, 0x98, 0x5F, 0xB0, 0x13}, {0x10, 0x26, 0x5F, 0x29, 0x12},
+    {0x00, 0x4E, 0x5F, 0x50, 0x12}, {0x08, 0x42, 0x5F, 0x44, 0x12}, {0x18, 0x1F, 0x5F, 0x22, 0x12}, {0x48, 0x4D, 0x5F, 0x4F, 0x12},
+    {0x98, 0xBB, 0x5F, 0xD0, 0x13}, {0x70, 0x8F, 0x5F, 0xA8, 0x13}, {0x88, 0xB6, 0x5F, 0xCB, 0x13}, {0xF0, 0x1B, 0x5F, 0x1F, 0x12},
+    {0x58, 0x69, 0x5F, 0x69, 0x12}, {0xD8, 0x5D, 0x5F, 0x5F, 0x12}, {0x88, 0xB8, 0x5F, 0xCD, 0x13}, {0xC0, 0xA7, 0x5F, 0xBE, 0x13},
+    {0x48, 0x8B, 0x5F, 0xA4, 0x13}, {0x68, 0x36, 0x5F, 0x39, 0x12}, {0x70, 0x29, 0x5F, 0x2C, 0x12}, {0xC0, 0xB0, 0x5F, 0xC6, 0x13},
+    {0x68, 0xA5, 0x5F, 0xBC, 0x13}, {0xE0, 0x60, 0x5F, 0x62, 0x12}, {0xB8, 0x72, 0x5F, 0x72, 0x12}, {0x20, 0x99, 0x5F, 0xB1, 0x13},
+    {0xA0, 0x63, 0x5F, 0x64, 0x12}, {0x90, 0xBD, 0x5F, 0xD2, 0x13}, {0xE8, 0x1A, 0x5F, 0x1E, 0x12}, {0x80, 0x9D, 0x5F, 0xB5, 0x13},
+    {0x78, 0x91, 0x5F, 0xAA, 0x13}, {0x48, 0x11, 0x5F, 0x13, 0x12}, {0xA0, 0x15, 0x5F, 0x18, 0x12}, {0x88, 0x3D, 0x5F, 0x40, 0x12},
+    {0x58, 0x9B, 0x5F, 0xB3, 0x13}, {0xD0, 0x7E, 0x5F, 0xE1, 0x12}, {0xC0, 0xBF, 0x5F, 0xD4, 0x13}, {0x50, 0xB4, 0x5F, 0xC9, 0x13},
+    {0xA0, 0x46, 0x5F, 0x48, 0x12}, {0x50, 0x84, 0x5F, 0xE7, 0x12}, {0x68, 0x16, 0x5F, 0x19, 0x12}, {0xD0, 0x80, 0x5F, 0xE3, 0x12},
+    {0x10, 0x6B, 0x5F, 0x6B, 0x12}, {0x80, 0x2B, 0x5F, 0x2E, 0x12}, {0xA0, 0x6F, 0x5F, 0x6F, 0x12}, {0x00, 0x4F, 0x5F, 0x51, 0x12},
+    {0x28, 0xA3, 0x5F, 0xBA, 0x13}, {0xB8, 0x23, 0x5F, 0x27, 0x12}, {0xA0, 0x82, 0x5F, 0xE5, 0x12}, {0x10, 0x1A, 0x5F, 0x1D, 0x12},
+    {0x38, 0x44, 0x5F, 0x46, 0x12}, {0x88, 0x58, 0x5F, 0x5A, 0x12}, {0x70, 0x9C, 0x5F, 0xB4, 0x13}, {0xD0, 0x5E, 0x5F, 0x60, 0x12},
+    {0x48, 0x27, 0x5F, 0x2A, 0x12}, {0x98, 0x95, 0x5F, 0xAE, 0x13}, {0x00, 0x20, 0x5F, 0x23, 0x12}, {0xC8, 0x7B, 0x5F, 0xDE, 0x12},
+    {0x30, 0x2D, 0x5F, 0x30, 0x12}, {0xA8, 0x73, 0x5F, 0x73, 0x12}, {0xD0, 0x7F, 0x5F, 0xE2, 0x12}, {0x68, 0x56, 0x5F, 0x58, 0x12},
+    {0x70, 0xAE, 0x5F, 0xC4, 0x13}, {0xF8, 0x40, 0x5F, 0x43, 0x12}, {0x80, 0x93, 0x5F, 0xAC, 0x13}, {0x70, 0x90, 0x5F, 0xA9, 0x13},
+    {0xA0, 0x3A, 0x5F, 0x3D, 0x12}, {0x48, 0xAB, 0x5F, 0xC1, 0x13}, {0xA0, 0xAD, 0x5F, 0xC3, 0x13}, {0xB8, 0x47, 0x5F, 0x49, 0x12},
+    {0xD8, 0x86, 0x5F, 0xEA, 0x12}, {0xC0, 0x96, 0x5F, 0xAF, 0x13}, {0x80, 0x83, 0x5F, 0xE6, 0x12}, {0x28, 0x6A, 0x5F, 0x6A, 0x12},
+    {0x30, 0x8A, 0x5F, 0xA3, 0x13}, {0x28, 0x30, 0x5F, 0x33, 0x12}, {0xD8, 0x7D, 0x5F, 0xE0, 0x12}, {0xC8, 0x7A, 0x5F, 0xDD, 0x12},
+    {0x00, 0xC1, 0x5F, 0xD5, 0x13}, {0x90, 0x5B, 0x5F, 0x5D, 0x12}, {0xA8, 0x6E, 0x5F, 0x6E, 0x12}, {0x40, 0x45, 0x5F, 0x47, 0x12},
+    {0x58, 0x8C, 0x5F, 0xA5, 0x13}, {0xC8, 0x79, 0x5F, 0xDC, 0x12}, {0x68, 0x33, 0x5F, 0x36, 0x12}, {0xD8, 0x49, 0x5F, 0x4B, 0x12},
+    {0x38, 0x51, 0x5F, 0x53, 0x12}, {0x90, 0xB9, 0x5F, 0xCE, 0x13}, {0x80, 0x34, 0x5F, 0x37, 0x12}, {0x20, 0x12, 0x5F, 0x14, 0x12},
+    {0x80, 0x39, 0x5F, 0x3C, 0x12}, {0xD0, 0x48, 0x5F, 0x4A, 0x12}, {0x68, 0x8E, 0x5F, 0xA7, 0x13}, {0xC0, 0x5C, 0x5F, 0x5E, 0x12},
+    {0x50, 0x55, 0x5F, 0x57, 0x12}, {0x60, 0x54, 0x5F, 0x56, 0x12}, {0x68, 0x5A, 0x5F, 0x5C, 0x12}, {0x18, 0x50, 0x5F, 0x52, 0x12},
+    {0x08, 0x52, 0x5F, 0x54, 0x12}, {0x90, 0xBC, 0x5F, 0xD1, 0x13}, {0x08, 0xA2, 0x5F, 0xB9, 0x13}, {0x30, 0x13, 0x5F, 0x15, 0x12},
+    {0x60, 0x2C, 0x5F, 0x2F, 0x12}, {0x80, 0x3C, 0x5F, 0x3F, 0x12}, {0x20, 0x85, 0x5F, 0xE8, 0x12}, {0xB0, 0x66, 0x5F, 0x67, 0x12},
+    {0x00, 0x2F, 0x5F, 0x32, 0x12}, {0x70, 0xAC, 0x5F, 0xC2, 0x13}, {0xC8, 0x14, 0x5F, 0x17, 0x12}, {0xC0, 0x4A, 0x5F, 0x4C, 0x12},
+    {0xD0, 0x75, 0x5F, 0x75, 0x12}, {0x98, 0x9E, 0x5F, 0xB6, 0x13}, {0x98, 0x4B, 0x5F, 0x4D, 0x12}, {0xD0, 0x7C, 0x5F, 0xDF, 0x12},
+    {0xE8, 0x67, 0x5F, 0x68, 0x12}, {0xE0, 0xA0, 0x5F, 0xB8, 0x13}, {0xE0, 0x1C, 0x5F, 0x20, 0x12}, {0xE8, 0xB1, 0x5F, 0xC7, 0x13},
+    {0xB0, 0x87, 0x5F, 0xEB, 0x12}, {0x60, 0x38, 0x5F, 0x3B, 0x12}, {0x70, 0x62, 0x5F, 0x63, 0x12}, {0x50, 0x59, 0x5F, 0x5B, 0x12},
+    {0xC8, 0x9F, 0x5F, 0xB7, 0x13}, {0x08, 0x3F, 0x5F, 0x41, 0x12}, {0x40, 0x19, 0x5F, 0x1C, 0x12}, {0xF0, 0x1D, 0x5F, 0x21, 0x12},
+    {0xC8, 0x78, 0x5F, 0xDB, 0x12}, {0x78, 0x37, 0x5F, 0x3A, 0x12}, {0x40, 0x17, 0x5F, 0x1A, 0x12}, {0xD0, 0x81, 0x5F, 0xE4, 0x12},
+    {0x28, 0xAA, 0x5F, 0xC0, 0x13}, {0x88, 0x92, 0x5F, 0xAB, 0x13}, {0xA0, 0x22, 0x5F, 0x26, 0x12}, {0xA8, 0x65, 0x5F, 0x66, 0x12},
+    {0x58, 0x77, 0x5F, 0x76, 0x12}, {0x28, 0x53, 0x5F, 0x55, 0x12}, {0x50, 0x31, 0x5F, 0x34, 0x12}, {0x90, 0xBE, 0x5F, 0xD3, 0x13},
+    {0xF0, 0x21, 0x5F, 0x25, 0x12}, {0x88, 0x28, 0x5F, 0x2B, 0x12}, {0x00, 0xA9, 0x5F, 0xBF, 0x13}, {0x70, 0x70, 0x5F, 0x70, 0x12},
+    {0x88, 0x71, 0x5F, 0x71, 0x12}, {0x50, 0xA4, 0x5F, 0xBB, 0x13}, {0xE8, 0x24, 0x5F, 0x28, 0x12}, {0x58, 0x89, 0x5F, 0xED, 0x12},
+    {0x60, 0x8D, 0x5F, 0xA6, 0x13}, {0x78, 0x64, 0x5F, 0x65, 0x12}, {0x90, 0x57, 0x5F, 0x59, 0x12}, {0xF0, 0x74, 0x5F, 0x74, 0x12},
+    {0xF8, 0x85, 0x5F, 0xE9, 0x12}, {0x28, 0x32, 0x5F, 0x35, 0x12},
+};
+
+const DIC_HASH quizHash = {
+    .displace = quizDisplace,
+    .entries = quizEntries,
+    .buckets = 43,
+    .size = 170,
+};
+
+static const uint16_t gruntyDisplace[8] = {
+    5, 83, 21, 21, 206, 68, 0, 16,
+};
+
+static const uint8_t gruntyEntries[30][5] = {
+    {0xA8, 0xE0, 0x5F, 0x21, 0x14}, {0x10, 0xD0, 0x5F, 0x13, 0x14}, {0x08, 0xD7, 0x5F, 0x19, 0x14}, {0x98, 0xD4, 0x5F, 0x17, 0x14},
+    {0x90, 0xC5, 0x5F, 0x0A, 0x14}, {0x10, 0xCA, 0x5F, 0x0E, 0x14}, {0xE0, 0xCE, 0x5F, 0x12, 0x14}, {0xE0, 0xC8, 0x5F, 0x0D, 0x14},
+    {0xA8, 0xC6, 0x5F, 0x0B, 0x14}, {0x58, 0xD2, 0x5F, 0x15, 0x14}, {0x10, 0xDD, 0x5F, 0x1E, 0x14}, {0x40, 0xDE, 0x5F, 0x1F, 0x14},
+    {0x80, 0xD3, 0x5F, 0x16, 0x14}, {0x48, 0xC3, 0x5F, 0x08, 0x14}, {0xD8, 0xC7, 0x5F, 0x0C, 0x14}, {0xD0, 0xE1, 0x5F, 0x22, 0x14},
+    {0xC0, 0xDA, 0x5F, 0x1C, 0x14}, {0x90, 0xCC, 0x5F, 0x10, 0x14}, {0x30, 0xCB, 0x5F, 0x0F, 0x14}, {0xF8, 0xE3, 0x5F, 0x24, 0x14},
+    {0xC8, 0xCD, 0x5F, 0x11, 0x14}, {0xF8, 0xE2, 0x5F, 0x23, 0x14}, {0x38, 0xC2, 0x5F, 0x07, 0x14}, {0x38, 0xD8, 0x5F, 0x1A, 0x14},
+    {0xD0, 0xD5, 0x5F, 0x18, 0x14}, {0x58, 0xC4, 0x5F, 0x09, 0x14}, {0x68, 0xDF, 0x5F, 0x20, 0x14}, {0x70, 0xD9, 0x5F, 0x1B, 0x14},
+    {0x00, 0xDC, 0x5F, 0x1D, 0x14}, {0x38, 0xD1, 0x5F, 0x14, 0x14},
+};
+
+const DIC_HASH gruntyHash = {
+    .displace = gruntyDisplace,
+    .entries = gruntyEntries,
+    .buckets = 8,
+    .size = 30,
+};
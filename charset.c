@@ -0,0 +1,377 @@
+#include <string.h>
+
+#include "charset.h"
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+const CHARSET *charsetFind(const char *name)
+{
+    for(size_t i = 0; i < charsetCount; i++)
+        if(strcmp(charsets[i].name, name) == 0)
+            return charsets + i;
+
+    return NULL;
+}
+
+/*
+ * Transcodes the character or control code at src[i] and returns the index of the next one
+ *
+ * Returns i unchanged if it doesn't fit in front of end. utf is constant at every call site, so this gets specialized.
+ */
+static inline size_t step(const CHARSET *cs, bool utf, const uint8_t *src, size_t i, size_t length, uint8_t **out, const uint8_t *end)
+{
+    uint8_t c = src[i];
+    uint8_t control = cs->control[c];
+    if(control != CHARSET_TEXT)
+    {
+        size_t n = length - i;
+        if(control == CHARSET_STOP)
+        {
+            // Copy as much of the rest as fits, an empty out makes the caller stop after this
+            if(n > (size_t)(end - *out))
+                n = end - *out;
+        }
+        else
+        {
+            if(n > control)
+                n = control;
+            if(n > (size_t)(end - *out))
+                return i;
+        }
+
+        memmove(*out, src + i, n);
+        *out += n;
+        return i + n;
+    }
+
+    if(utf)
+    {
+        // Always store both bytes if there's room for them, so there's no branch on the length
+        uint8_t n = cs->utf8Length[c];
+        if(end - *out >= 2)
+        {
+            (*out)[0] = cs->utf8[c][0];
+            (*out)[1] = cs->utf8[c][1];
+        }
+        else if(end - *out == n)
+            (*out)[0] = cs->utf8[c][0];
+        else
+            return i;
+
+        *out += n;
+    }
+    else
+    {
+        if(end == *out)
+            return i;
+
+        *(*out)++ = cs->iso[c];
+    }
+
+    return i + 1;
+}
+
+static inline size_t transcodeScalar(const CHARSET *cs, bool utf, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    uint8_t *out = dst;
+    const uint8_t *end = dst + capacity;
+    for(size_t i = 0, next; i < length; i = next)
+    {
+        next = step(cs, utf, src, i, length, &out, end);
+        if(next == i)
+            break;
+    }
+
+    return out - dst;
+}
+
+size_t charsetToIsoScalar(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    return transcodeScalar(cs, false, src, length, dst, capacity);
+}
+
+size_t charsetToUtf8Scalar(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    return transcodeScalar(cs, true, src, length, dst, capacity);
+}
+
+/*
+ * Copies the control or stop code at src[i] verbatim and returns the index of the next character
+ *
+ * Returns i unchanged if it doesn't fit in front of end.
+ */
+static inline size_t copyControl(const CHARSET *cs, const uint8_t *src, size_t i, size_t length, uint8_t **out, const uint8_t *end)
+{
+    size_t n = length - i;
+    if(cs->control[src[i]] != CHARSET_STOP && n > cs->control[src[i]])
+        n = cs->control[src[i]];
+    if(n > (size_t)(end - *out))
+        return i;
+
+    memmove(*out, src + i, n);
+    *out += n;
+    return i + n;
+}
+
+size_t charsetFromIso(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    uint8_t *out = dst;
+    const uint8_t *end = dst + capacity;
+    for(size_t i = 0; i < length && out < end; )
+    {
+        if(cs->control[src[i]] != CHARSET_TEXT)
+        {
+            size_t next = copyControl(cs, src, i, length, &out, end);
+            if(next == i)
+                break;
+
+            i = next;
+            continue;
+        }
+
+        *out++ = cs->fromIso[src[i++]];
+    }
+
+    return out - dst;
+}
+
+size_t charsetFromUtf8(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    uint8_t *out = dst;
+    const uint8_t *end = dst + capacity;
+    for(size_t i = 0; i < length && out < end; )
+    {
+        uint8_t c = src[i];
+        if(cs->control[c] != CHARSET_TEXT)
+        {
+            size_t next = copyControl(cs, src, i, length, &out, end);
+            if(next == i)
+                break;
+
+            i = next;
+        }
+        else if((c == 0xC2 || c == 0xC3) && i + 1 < length && (src[i + 1] & 0xC0) == 0x80)
+        {
+            *out++ = cs->fromIso[(c & 0x1F) << 6 | (src[i + 1] & 0x3F)];
+            i += 2;
+        }
+        else
+        {
+            // Unmapped bytes came through as is
+            *out++ = c < 0x80 ? cs->fromIso[c] : c;
+            i++;
+        }
+    }
+
+    return out - dst;
+}
+
+#if defined(__SSE4_1__)
+
+/*
+ * Shuffle tables for 8 (lead, byte) pairs with the mask of two byte characters m:
+ * They drop the lead bytes of the single byte characters, leaving 8 + popcount(m) bytes.
+ */
+static uint8_t expandShuffle[256][16];
+static uint8_t expandLength[256];
+
+__attribute__((constructor)) static void initExpandTables()
+{
+    for(int m = 0; m < 256; m++)
+    {
+        int p = 0;
+        for(int k = 0; k < 8; k++)
+        {
+            if(m & (1 << k))
+                expandShuffle[m][p++] = k * 2;
+
+            expandShuffle[m][p++] = k * 2 + 1;
+        }
+
+        expandLength[m] = p;
+        for(; p < 16; p++)
+            expandShuffle[m][p] = 0x80;
+    }
+}
+
+/*
+ * The SIMD tables of a character set, loaded once per call
+ *
+ * The first two rows live in registers, that's all the Rare character table needs. More rows get loaded as needed.
+ */
+typedef struct
+{
+    __m128i nibble[2];
+    __m128i delta[2];
+    __m128i mapped[2];
+    __m128i control[2];
+} CLASSIFIER;
+
+static inline void loadClassifier(const CHARSET *cs, CLASSIFIER *cl)
+{
+    for(int r = 0; r < 2; r++)
+    {
+        // Unused rows get a nibble no byte has
+        cl->nibble[r] = _mm_set1_epi8(r < cs->rowCount ? cs->rowNibble[r] : 0x10);
+        cl->delta[r] = _mm_loadu_si128((const __m128i *)cs->rowDelta[r]);
+        cl->mapped[r] = _mm_loadu_si128((const __m128i *)cs->rowMapped[r]);
+        cl->control[r] = _mm_loadu_si128((const __m128i *)cs->controlBits[r]);
+    }
+}
+
+/* Returns the ISO-8859-1 value of each byte in v and marks the ones the character set maps in mapped */
+static inline __m128i classify(const CHARSET *cs, const CLASSIFIER *cl, __m128i v, __m128i low, __m128i high, __m128i *mapped)
+{
+    __m128i row = _mm_cmpeq_epi8(high, cl->nibble[0]);
+    __m128i delta = _mm_and_si128(row, _mm_shuffle_epi8(cl->delta[0], low));
+    __m128i m = _mm_and_si128(row, _mm_shuffle_epi8(cl->mapped[0], low));
+    row = _mm_cmpeq_epi8(high, cl->nibble[1]);
+    delta = _mm_or_si128(delta, _mm_and_si128(row, _mm_shuffle_epi8(cl->delta[1], low)));
+    m = _mm_or_si128(m, _mm_and_si128(row, _mm_shuffle_epi8(cl->mapped[1], low)));
+
+    for(uint8_t r = 2; r < cs->rowCount; r++)
+    {
+        row = _mm_cmpeq_epi8(high, _mm_set1_epi8(cs->rowNibble[r]));
+        delta = _mm_or_si128(delta, _mm_and_si128(row, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)cs->rowDelta[r]), low)));
+        m = _mm_or_si128(m, _mm_and_si128(row, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)cs->rowMapped[r]), low)));
+    }
+
+    *mapped = m;
+    return _mm_add_epi8(v, delta);
+}
+
+/* Returns true if one of the bytes is a control or stop code */
+static inline bool hasControl(const CLASSIFIER *cl, __m128i low, __m128i high)
+{
+    const __m128i bit = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    __m128i bits = _mm_blendv_epi8(_mm_shuffle_epi8(cl->control[0], low), _mm_shuffle_epi8(cl->control[1], low), _mm_slli_epi16(high, 4));
+    return !_mm_testz_si128(bits, _mm_shuffle_epi8(bit, high));
+}
+
+/* Splits the bytes of v into nibbles */
+static inline void nibbles(__m128i v, __m128i *low, __m128i *high)
+{
+    *low = _mm_and_si128(v, _mm_set1_epi8(0x0F));
+    *high = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+}
+
+/*
+ * Chunks without control codes get converted with the classifier, chunks containing some go through the scalar path.
+ * A control code may consume bytes of the next chunk, so the scalar path simply continues at the first byte after it.
+ */
+size_t charsetToIso(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    if(capacity < CHARSET_ISO_MAX(length))
+        return charsetToIsoScalar(cs, src, length, dst, capacity);
+
+    CLASSIFIER cl;
+    loadClassifier(cs, &cl);
+    uint8_t *out = dst;
+    const uint8_t *end = dst + capacity;
+    size_t i = 0;
+    while(length - i >= 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i low, high;
+        nibbles(v, &low, &high);
+        if(hasControl(&cl, low, high))
+        {
+            size_t chunkEnd = i + 16;
+            while(i < chunkEnd)
+                i = step(cs, false, src, i, length, &out, end);
+
+            continue;
+        }
+
+        __m128i mapped;
+        _mm_storeu_si128((__m128i *)out, classify(cs, &cl, v, low, high, &mapped));
+        out += 16;
+        i += 16;
+    }
+
+    while(i < length)
+        i = step(cs, false, src, i, length, &out, end);
+
+    return out - dst;
+}
+
+/*
+ * Like charsetToIso() but chunks with characters outside of ASCII get interleaved with their lead bytes and compacted with a shuffle.
+ * The 16 byte stores never write past CHARSET_UTF8_MAX(length): A chunk starts at out <= 2 * i and writes at most 32 bytes
+ * with 16 input bytes left. Smaller buffers go through the scalar path.
+ */
+size_t charsetToUtf8(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    if(capacity < CHARSET_UTF8_MAX(length))
+        return charsetToUtf8Scalar(cs, src, length, dst, capacity);
+
+    CLASSIFIER cl;
+    loadClassifier(cs, &cl);
+    uint8_t *out = dst;
+    const uint8_t *end = dst + capacity;
+    size_t i = 0;
+    while(length - i >= 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i low, high;
+        nibbles(v, &low, &high);
+        if(hasControl(&cl, low, high))
+        {
+            size_t chunkEnd = i + 16;
+            while(i < chunkEnd)
+                i = step(cs, true, src, i, length, &out, end);
+
+            continue;
+        }
+
+        __m128i mapped;
+        __m128i iso = classify(cs, &cl, v, low, high, &mapped);
+
+        // Unmapped bytes stay single bytes, mapped ones above U+007F become 0xC2/0xC3 followed by a trail byte
+        int wideMask = _mm_movemask_epi8(_mm_and_si128(mapped, iso));
+        if(wideMask == 0)
+        {
+            _mm_storeu_si128((__m128i *)out, iso);
+            out += 16;
+        }
+        else
+        {
+            __m128i wide = _mm_and_si128(mapped, _mm_cmplt_epi8(iso, _mm_setzero_si128()));
+            __m128i bytes = _mm_blendv_epi8(iso, _mm_or_si128(_mm_and_si128(iso, _mm_set1_epi8(0x3F)), _mm_set1_epi8((char)0x80)), wide);
+            __m128i lead = _mm_sub_epi8(_mm_set1_epi8((char)0xC2), _mm_cmpeq_epi8(_mm_and_si128(iso, _mm_set1_epi8(0x40)), _mm_set1_epi8(0x40)));
+
+            int m = wideMask & 0xFF;
+            __m128i o = _mm_shuffle_epi8(_mm_unpacklo_epi8(lead, bytes), _mm_loadu_si128((const __m128i *)expandShuffle[m]));
+            _mm_storeu_si128((__m128i *)out, o);
+            out += expandLength[m];
+
+            m = wideMask >> 8;
+            o = _mm_shuffle_epi8(_mm_unpackhi_epi8(lead, bytes), _mm_loadu_si128((const __m128i *)expandShuffle[m]));
+            _mm_storeu_si128((__m128i *)out, o);
+            out += expandLength[m];
+        }
+
+        i += 16;
+    }
+
+    while(i < length)
+        i = step(cs, true, src, i, length, &out, end);
+
+    return out - dst;
+}
+
+#else
+
+size_t charsetToIso(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    return charsetToIsoScalar(cs, src, length, dst, capacity);
+}
+
+size_t charsetToUtf8(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity)
+{
+    return charsetToUtf8Scalar(cs, src, length, dst, capacity);
+}
+
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Table driven character sets
+ *
+ * Each one is defined in charsets/<name>.charset and turned into a CHARSET by tools/genCharset.c at build time.
+ * See charsets/rare.charset for the format.
+ *
+ * Every byte is one of:
+ *  - Text: Gets replaced with iso[c] respectively the utf8Length[c] bytes at utf8[c].
+ *    Bytes not mentioned by the definition map to themselves.
+ *  - A control code (control[c] != CHARSET_TEXT): It gets copied verbatim together with its control[c] - 1 argument bytes.
+ *  - A stop code (control[c] == CHARSET_STOP): It and everything after it gets copied verbatim.
+ *
+ * Mappings have to be in U+0000 - U+00FF, so UTF-8 takes at most 2 bytes per input byte.
+ *
+ * For the way back fromIso has the byte for each ISO-8859-1 character. If more than one byte maps to a character
+ * the lowest one mentioned by the definition wins, characters no byte maps to are kept as they are.
+ */
+#define CHARSET_TEXT 0x00
+#define CHARSET_STOP 0xFF
+
+#define CHARSET_ISO_MAX(length) (length)
+#define CHARSET_UTF8_MAX(length) ((length) * 2)
+
+/* The character set used without --charset */
+#define CHARSET_DEFAULT "rare"
+
+typedef struct
+{
+    const char *name;
+    uint8_t iso[256];
+    uint8_t utf8[256][2];
+    uint8_t utf8Length[256];
+    uint8_t control[256];
+    uint8_t fromIso[256];
+
+    // SIMD classifier: For each high nibble with mapped bytes the ISO-8859-1 value - byte and a 0xFF marker, indexed by the low nibble
+    uint8_t rowCount;
+    uint8_t rowNibble[16];
+    uint8_t rowDelta[16][16];
+    uint8_t rowMapped[16][16];
+    // Bitmaps of the control and stop codes, indexed by the low nibble. Bit n means high nibble n (first) or n + 8 (second)
+    uint8_t controlBits[2][16];
+} CHARSET;
+
+extern const CHARSET charsets[];
+extern const size_t charsetCount;
+
+const CHARSET *charsetFind(const char *name);
+
+/*
+ * Transcoders
+ *
+ * All of them read length bytes from src and write at most capacity bytes to dst, returning the number of bytes written.
+ * They never truncate inside a character or control code: With a capacity of at least CHARSET_ISO_MAX(length)
+ * respectively CHARSET_UTF8_MAX(length) the whole string fits. src and dst may be the same for the ISO-8859-1 transcoder.
+ * There's no global state, so they're safe to call from multiple threads.
+ *
+ * The default versions use SSE4.1 where available, the scalar versions give bit-identical results.
+ */
+size_t charsetToIso(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity);
+size_t charsetToUtf8(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity);
+
+size_t charsetToIsoScalar(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity);
+size_t charsetToUtf8Scalar(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity);
+
+/*
+ * Reverse transcoders, the output of the ones above back to the game encoding
+ *
+ * Control and stop codes are copied verbatim, just like on the way there. Bytes in the UTF-8 input which aren't part
+ * of a two byte character are taken as unmapped bytes. The output is never longer than the input.
+ */
+size_t charsetFromIso(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity);
+size_t charsetFromUtf8(const CHARSET *cs, const uint8_t *src, size_t length, uint8_t *dst, size_t capacity);
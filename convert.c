@@ -0,0 +1,356 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "convert.h"
+#include "probes.h"
+
+typedef struct __attribute__((__packed__))
+{
+    uint16_t offsets[3];
+} LANGUAGE_FILE;
+
+typedef struct __attribute__((__packed__))
+{
+    uint8_t cmd;
+    uint8_t length;
+    char msg[];
+} MESSAGE;
+
+typedef struct __attribute__((__packed__))
+{
+    uint8_t count;
+    MESSAGE start[];
+} DIALOGUE;
+
+const char *lang[3] = {"EN", "FR", "DE"};
+const char *typeDir[DIC_TYPES] = {"dialog", "quiz_q", "grunty_q"};
+
+/*
+ * Maps a .bin filename to the corresponding .dialog/.quiz_q/.grunty_q filename
+ *
+ * Expects a 6 char string as input and writes a 4 char string to out
+ * (null terminators not counted nor needed as it reads 6 and writes 4 bytes only)
+ * Returns the numeric value of the name or DIC_MISS in case of no map entry
+ */
+int32_t mapName(const DICTIONARY *dic, DIC_TYPE type, const char *in, char *out)
+{
+    int32_t value = dictionaryLookup(dic, type, dicKey(in));
+    if(value == DIC_MISS)
+        return DIC_MISS;
+
+    for(int i = 3, v = value; i >= 0; i--, v >>= 4)
+        out[i] = "0123456789ABCDEF"[v & 0x0F];
+
+    return value;
+}
+
+/*
+ * Length of a messages string
+ *
+ * MESSAGE.length counts the null terminator, only fall back to scanning for it if the message is malformed
+ */
+static inline size_t messageLength(const MESSAGE *msg)
+{
+    if(msg->length != 0 && msg->msg[msg->length - 1] == '\0')
+        return msg->length - 1;
+
+    return strnlen(msg->msg, msg->length);
+}
+
+/*
+ * Emits a message, converting its string to ISO-8859-1/UTF-8 if requested
+ *
+ * The string gets transcoded straight into the output buffer, which is sized for the worst case expansion up front.
+ * The blob itself is never modified. If a string table gets built the message goes there as well, always as UTF-8.
+ */
+static bool emitConverted(OUTPUT *output, unsigned int section, const MESSAGE *msg, bool transform, const char *prefix, size_t prefixLength, const CONFIG *config)
+{
+    EMITTER *out = &output->buf;
+    size_t length = messageLength(msg);
+    if(output->strtab != NULL &&
+       !strtabAdd(output->strtab, section, msg->cmd, ANSWER_PREFIX, prefixLength ? sizeof(ANSWER_PREFIX) - 1 : 0,
+                  msg->msg, length, transform ? config->charset : NULL))
+        return false;
+
+    if(!transform || !(config->convert & (TO_ISO | TO_UTF)))
+        return emitMessage(out, msg->cmd, prefix, prefixLength, msg->msg, length);
+
+    bool utf = !(config->convert & TO_ISO);
+    size_t capacity = utf ? CHARSET_UTF8_MAX(length) : CHARSET_ISO_MAX(length);
+    char *m = emitMessageBegin(out, msg->cmd, prefix, prefixLength, capacity);
+    if(m == NULL)
+        return false;
+
+    PHASE prev = statsEnter(output->stats, PHASE_TRANSCODE);
+    PROBE2(transcode__start, length, utf);
+    const uint8_t *src = (const uint8_t *)msg->msg;
+    size_t outLength;
+    if(utf)
+        outLength = charsetToUtf8(config->charset, src, length, (uint8_t *)m, capacity);
+    else
+        outLength = charsetToIso(config->charset, src, length, (uint8_t *)m, capacity);
+
+    PROBE2(transcode__done, length, outLength);
+    m += outLength;
+    statsEnter(output->stats, prev);
+    emitMessageEnd(out, m);
+    return true;
+}
+
+/*
+ * Parse a .bin file representing a .quiz_q file
+ *
+ * This will map the .bin file to the corresponding .quiz_q file and create said .quiz_q file with YAML content.
+ * It will write to stderr and skip the .bin file in case of no map entry (no .dialog file to write to known)
+ */
+static int parseQuiz(const uint8_t *blob, const char *name, bool grunty, const CONFIG *config, OUTPUT *out)
+{
+    DIC_TYPE type = grunty ? DIC_GRUNTY : DIC_QUIZ;
+    char outName[4];
+    PHASE prev = statsEnter(out->stats, PHASE_LOOKUP);
+    int32_t id = mapName(config->dic, type, name, outName);
+    statsEnter(out->stats, prev);
+    if(id == DIC_MISS)
+    {
+        if(out->stats != NULL)
+            out->stats->unmapped[type]++;
+
+        PROBE2(dict__miss, name, type);
+        fprintf(stderr, "No map entry for quiz_q %s.bin\n", name);
+        return 0;
+    }
+
+    // The path buffer for the files to write to. The Xes will be replaced later
+    char outPath[grunty ? sizeof("XX/grunty_q/XXXX.grunty_q") : sizeof("XX/quiz_q/XXXX.quiz_q")];
+    size_t pl;
+    if(grunty)
+    {
+        memcpy(outPath, "XX/grunty_q/XXXX.grunty_q", sizeof("XX/grunty_q/XXXX.grunty_q"));
+        pl = sizeof("XX/grunty_q/") - 1;
+    }
+    else
+    {
+        memcpy(outPath, "XX/quiz_q/XXXX.quiz_q", sizeof("XX/quiz_q/XXXX.quiz_q"));
+        pl = sizeof("XX/quiz_q/") - 1;
+    }
+
+    // Replace XXXX with the file name
+    memcpy(outPath + pl, outName, 4);
+
+    // The control bytes to add to the beginning of answers
+    const char *prefix = "";
+    size_t prefixLength = 0;
+    if(config->convert & TO_CON)
+    {
+        prefix = config->convert & TO_COM ? ANSWER_PREFIX : ANSWER_PREFIX_ESCAPED;
+        prefixLength = strlen(prefix);
+    }
+
+    // Cast the blob into a LANGUAGE_FILE struct
+    const LANGUAGE_FILE *lf = (const LANGUAGE_FILE *)(blob + 0x03);
+
+    // Loop over the DIALOGUE structs to get count of and the pointers for the MESSAGE structs in the blob
+    for(int i = 0; i < 3; i++)
+    {
+        // Replace the XX in out path buffer with the language (EN/FR/DE)
+        memcpy(outPath, lang[i], 2);
+        if(out->strtab != NULL)
+            strtabBeginFile(out->strtab, i, type, id);
+
+        emitterReset(&out->buf);
+        bool ok = emitLiteral(&out->buf, "type: QuizQuestion\n"
+                                   "question:\n");
+
+        // Point and cast to the DIALOGUE structs found in the blob
+        // Each DIALOGUE struct corresponds to one language (EN/FR/DE)
+        const DIALOGUE *diag = (const DIALOGUE *)(blob + lf->offsets[i]);
+
+        const MESSAGE *msg = diag->start;
+        bool firstAnswer = true;
+
+        // Loop over the MESSAGE structs found
+        // Parse them and render them as YAML
+        for(uint8_t j = 0; ok && j < diag->count; j++)
+        {
+            if(firstAnswer && msg->cmd & ~(0x80))
+            {
+                ok = emitLiteral(&out->buf, "options:\n");
+                firstAnswer = false;
+            }
+
+            ok = ok && emitConverted(out, firstAnswer ? 0 : 1, msg, true, prefix, firstAnswer ? 0 : prefixLength, config);
+            msg = (const MESSAGE *)(((const uint8_t *)msg) + 2 + msg->length);
+        }
+
+        if(out->stats != NULL)
+        {
+            out->stats->messages[type] += diag->count;
+            out->stats->bytesOut[type] += out->buf.size;
+        }
+
+        PROBE3(output__render, outPath, out->buf.size, diag->count);
+        if(!ok || !out->write(out, i, type, outPath, pl))
+            return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Parse a .bin file representing a .dialog file
+ *
+ * This will map the .bin file to the corresponding .dialog file and create said .dialog file with YAML content.
+ * It will write to stderr and skip the .bin file in case of no map entry (no .dialog file to write to known)
+ */
+static int parseDialog(const uint8_t *blob, const char *name, const CONFIG *config, OUTPUT *out)
+{
+    char outName[4];
+    PHASE prev = statsEnter(out->stats, PHASE_LOOKUP);
+    int32_t id = mapName(config->dic, DIC_DIALOG, name, outName);
+    statsEnter(out->stats, prev);
+    if(id == DIC_MISS)
+    {
+        if(out->stats != NULL)
+            out->stats->unmapped[DIC_DIALOG]++;
+
+        PROBE2(dict__miss, name, DIC_DIALOG);
+        fprintf(stderr, "No map entry for dialog %s.bin\n", name);
+        return 0;
+    }
+
+    char outPath[] = "XX/dialog/XXXX.dialog";
+    memcpy(outPath + sizeof("XX/dialog/") - 1, outName, 4);
+
+    const LANGUAGE_FILE *lf = (const LANGUAGE_FILE *)(blob + 0x01);
+    for(int i = 0; i < 3; i++)
+    {
+        memcpy(outPath, lang[i], 2);
+//        printf("--> %s\n", outPath);
+        if(out->strtab != NULL)
+            strtabBeginFile(out->strtab, i, DIC_DIALOG, id);
+
+        // Loop over bottom messages
+        emitterReset(&out->buf);
+        bool ok = emitLiteral(&out->buf, "type: Dialog\n"
+                                   "bottom:\n");
+        const DIALOGUE *diag = (const DIALOGUE *)(blob + lf->offsets[i]);
+        const MESSAGE *msg = diag->start;
+        uint8_t count = diag->count;
+        bool special = false;
+        for(uint8_t j = 0; ok && j < count; j++)
+        {
+            ok = emitConverted(out, 0, msg, dialogTransform(msg->cmd, &special), "", 0, config);
+
+            msg = (const MESSAGE *)(((const uint8_t *)msg) + 2 + msg->length);
+        }
+
+        // Loop over top messages
+        ok = ok && emitLiteral(&out->buf, "top:\n");
+        uint8_t bottomCount = count;
+        count = *(const uint8_t *)msg;
+        msg = (const MESSAGE *)(((const uint8_t *)msg) + 0x01);
+        for(uint8_t j = 0; ok && j < count; j++)
+        {
+            ok = emitConverted(out, 1, msg, msg->cmd & 0x80, "", 0, config);
+            msg = (const MESSAGE *)(((const uint8_t *)msg) + 2 + msg->length);
+        }
+
+        if(out->stats != NULL)
+        {
+            out->stats->messages[DIC_DIALOG] += bottomCount + count;
+            out->stats->bytesOut[DIC_DIALOG] += out->buf.size;
+        }
+
+        PROBE3(output__render, outPath, out->buf.size, bottomCount + count);
+        // Write the .dialog file
+        if(!ok || !out->write(out, i, DIC_DIALOG, outPath, sizeof("XX/dialog/") - 1))
+            return 1;
+    }
+
+    return 0;
+}
+
+/* Tells the type of a .bin file by its file magic (first two bytes), DIC_TYPES if unknown */
+DIC_TYPE blobType(const uint8_t *blob)
+{
+    switch(*(const uint16_t *)blob)
+    {
+        case 0x0703: // .dialog
+            return DIC_DIALOG;
+        case 0x0103: // .quiz_q
+            return DIC_QUIZ;
+        case 0x0303: // .grunty_q
+            return DIC_GRUNTY;
+        default:
+            return DIC_TYPES;
+    }
+}
+
+/*
+ * Size of a .bin file by walking its structure, for inputs without a size of their own (--image)
+ *
+ * Returns 0 if it's not a .bin file or if any of it would be beyond max, so parseBlob() is safe on what passes.
+ */
+size_t blobSize(const uint8_t *blob, size_t max)
+{
+    if(max < 3 + sizeof(LANGUAGE_FILE))
+        return 0;
+
+    DIC_TYPE type = blobType(blob);
+    if(type == DIC_TYPES)
+        return 0;
+
+    // Dialogs have a bottom and a top message list per language, quizzes a single one
+    size_t header = type == DIC_DIALOG ? 0x01 : 0x03;
+    const LANGUAGE_FILE *lf = (const LANGUAGE_FILE *)(blob + header);
+    size_t end = header + sizeof(LANGUAGE_FILE);
+    for(int i = 0; i < 3; i++)
+    {
+        size_t pos = lf->offsets[i];
+        for(int list = 0; list < (type == DIC_DIALOG ? 2 : 1); list++)
+        {
+            if(pos >= max)
+                return 0;
+
+            uint8_t count = blob[pos++];
+            for(uint8_t j = 0; j < count; j++)
+            {
+                if(pos + 2 > max)
+                    return 0;
+
+                pos += 2 + blob[pos + 1];
+            }
+
+            if(pos > max)
+                return 0;
+        }
+
+        if(pos > end)
+            end = pos;
+    }
+
+    return end;
+}
+
+/*
+ * This parses a .bin file already in memory
+ *
+ * So it parses its file magic to decide if dialog or quiz_q
+ * and handles the blob to the corresponding parser function
+ */
+int parseBlob(const uint8_t *blob, const char *name, const char *file, const CONFIG *config, OUTPUT *out)
+{
+    DIC_TYPE type = blobType(blob);
+    PROBE3(dispatch, name, type, *(const uint16_t *)blob);
+    switch(type)
+    {
+        case DIC_DIALOG:
+            return parseDialog(blob, name, config, out);
+        case DIC_QUIZ:
+        case DIC_GRUNTY:
+            return parseQuiz(blob, name, type == DIC_GRUNTY, config, out);
+        default:
+            fprintf(stderr, "Unknown file magic for %s: 0x%04X\n", file, *(const uint16_t *)blob);
+            return 1;
+    }
+}
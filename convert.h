@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "charset.h"
+#include "dictionary.h"
+#include "emitter.h"
+#include "stats.h"
+#include "strtab.h"
+#include "trace.h"
+
+#define TO_RAW 0x00
+#define TO_ISO 0x01
+#define TO_UTF 0x02
+#define TO_CON 0x04
+#define TO_COM 0x08
+
+/* Input files have to be smaller than this */
+#define INPUT_MAX 4096
+
+// The control bytes added to the beginning of answers
+#define ANSWER_PREFIX "\xFDl"
+#define ANSWER_PREFIX_ESCAPED "\\xFDl"
+
+extern const char *lang[3];
+extern const char *typeDir[DIC_TYPES];
+
+/* Read-only settings of a run, shared by all workers */
+typedef struct
+{
+    unsigned int convert;
+    const DICTIONARY *dic;
+    const CHARSET *charset;
+} CONFIG;
+
+/*
+ * Where the parsers put their output files
+ *
+ * The parsers render each file into buf and call write() for it. path is the full path of the file
+ * ("XX/dialog/XXXX.dialog" and so on), the filename starts at path + nameOffset.
+ * ctx is for the writer, the parsers don't touch it.
+ * The parsers also add every message to strtab and count into stats, if they're not NULL. trace is for the writers.
+ */
+typedef struct OUTPUT OUTPUT;
+struct OUTPUT
+{
+    EMITTER buf;
+    bool (*write)(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset);
+    void *ctx;
+    STRTAB_BUILDER *strtab;
+    STATS *stats;
+    TRACE *trace;
+};
+
+/*
+ * Tells if the string of a message in the bottom section of a dialog is text
+ *
+ * Messages with the high bit set are, after the first one with 0x40 set (or 0xBC) also the ones with 0x08 set.
+ * special tracks that, it has to start as false for each dialog.
+ */
+static inline bool dialogTransform(uint8_t cmd, bool *special)
+{
+    bool transform = (cmd & 0x80) || (*special && (cmd & 0x08));
+    if(transform && !*special)
+        *special = cmd & 0x40 || cmd == 0xBC; // is 0xBC a game bug? Cause others are 0xCB, 0xD0, 0xD1
+
+    return transform;
+}
+
+int32_t mapName(const DICTIONARY *dic, DIC_TYPE type, const char *in, char *out);
+DIC_TYPE blobType(const uint8_t *blob);
+size_t blobSize(const uint8_t *blob, size_t max);
+int parseBlob(const uint8_t *blob, const char *name, const char *file, const CONFIG *config, OUTPUT *out);
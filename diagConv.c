@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "convert.h"
+#include "diagConv.h"
+
+struct DIAGCONV
+{
+    CONFIG config;
+    DICTIONARY dic;
+};
+
+/* Where diagConvConvert() puts the rendered files, either the callers buffer or a growing arena */
+typedef struct
+{
+    DIAGCONV_RESULT *result;
+    char *buf;
+    size_t bufSize;
+    bool arena;
+    size_t offset[3];
+} SINK;
+
+/* OUTPUT writer: Copies a rendered file into the sink. Files which don't fit get counted but not copied */
+static bool sinkOutput(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset)
+{
+    (void)type;
+    (void)nameOffset;
+    SINK *sink = out->ctx;
+    DIAGCONV_RESULT *r = sink->result;
+    if(sink->arena && r->needed + out->buf.size > sink->bufSize)
+    {
+        size_t size = sink->bufSize ? sink->bufSize : 16384;
+        while(size < r->needed + out->buf.size)
+            size *= 2;
+
+        char *buf = realloc(sink->buf, size);
+        if(buf == NULL)
+            return false;
+
+        sink->buf = buf;
+        sink->bufSize = size;
+    }
+
+    if(r->needed + out->buf.size <= sink->bufSize)
+        memcpy(sink->buf + r->needed, out->buf.data, out->buf.size);
+
+    snprintf(r->path[language], sizeof(r->path[language]), "%s", path);
+    sink->offset[language] = r->needed;
+    r->size[language] = out->buf.size;
+    r->needed += out->buf.size;
+    return true;
+}
+
+DIAGCONV *diagConvNew(const DIAGCONV_OPTIONS *options)
+{
+    DIAGCONV_OPTIONS defaults = {
+        .size = sizeof(DIAGCONV_OPTIONS),
+        .strings = DIAGCONV_STRINGS_RAW,
+        .control = DIAGCONV_CONTROL_NONE,
+        .charset = NULL,
+        .dictFile = NULL,
+    };
+
+    // Callers built against an older header pass a smaller struct, the fields they don't know keep the defaults
+    if(options != NULL)
+    {
+        if(options->size < offsetof(DIAGCONV_OPTIONS, strings) + sizeof(options->strings))
+            return NULL;
+
+        memcpy(&defaults, options, options->size < sizeof(defaults) ? options->size : sizeof(defaults));
+    }
+
+    const CHARSET *charset = charsetFind(defaults.charset != NULL ? defaults.charset : CHARSET_DEFAULT);
+    if(charset == NULL || defaults.strings > DIAGCONV_STRINGS_UTF8 || defaults.control > DIAGCONV_CONTROL_BINARY)
+        return NULL;
+
+    DIAGCONV *dc = malloc(sizeof(DIAGCONV));
+    if(dc == NULL)
+        return NULL;
+
+    dictionaryInit(&dc->dic);
+    if(defaults.dictFile != NULL && !dictionaryLoad(&dc->dic, defaults.dictFile))
+    {
+        free(dc);
+        return NULL;
+    }
+
+    static const unsigned int strings[] = { TO_RAW, TO_ISO, TO_UTF };
+    static const unsigned int control[] = { 0, TO_CON, TO_CON | TO_COM };
+    dc->config.convert = strings[defaults.strings] | control[defaults.control];
+    dc->config.dic = &dc->dic;
+    dc->config.charset = charset;
+    return dc;
+}
+
+void diagConvFree(DIAGCONV *dc)
+{
+    if(dc == NULL)
+        return;
+
+    dictionaryUnload(&dc->dic);
+    free(dc);
+}
+
+DIAGCONV_STATUS diagConvConvert(const DIAGCONV *dc, const void *blob, size_t size, uint32_t id, void *buf, size_t bufSize,
+                                DIAGCONV_RESULT *result)
+{
+    if(dc == NULL || blob == NULL || result == NULL || id > 0xFFFFFF)
+        return DIAGCONV_ERR_ARGS;
+
+    memset(result, 0, sizeof(DIAGCONV_RESULT));
+    if(size <= 32 || size >= INPUT_MAX)
+        return DIAGCONV_ERR_SIZE;
+
+    // Same buffer as diagConv reads into, so a blob can't make the parser read more than it would there
+    uint8_t in[INPUT_MAX];
+    memcpy(in, blob, size);
+    memset(in + size, 0, INPUT_MAX - size);
+
+    DIC_TYPE type = blobType(in);
+    if(type == DIC_TYPES)
+        return DIAGCONV_ERR_MAGIC;
+
+    // parseBlob() trusts the offsets in the blob, blobSize() walks them without
+    size_t needed = blobSize(in, size);
+    if(needed == 0 || needed > size)
+        return DIAGCONV_ERR_FORMAT;
+
+    // Check the mapping up front, parseBlob() would only complain on stderr
+    char name[6 + 1];
+    char outName[4];
+    snprintf(name, sizeof(name), "%06X", id);
+    if(mapName(&dc->dic, type, name, outName) == DIC_MISS)
+        return DIAGCONV_ERR_UNMAPPED;
+
+    result->type = (DIAGCONV_TYPE)type;
+    for(int i = 0; i < 3; i++)
+        memcpy(result->language[i], lang[i], 3);
+
+    SINK sink = {
+        .result = result,
+        .buf = buf,
+        .bufSize = buf != NULL ? bufSize : 0,
+        .arena = buf == NULL,
+    };
+
+    OUTPUT out = {
+        .write = sinkOutput,
+        .ctx = &sink,
+        .strtab = NULL,
+        .stats = NULL,
+        .trace = NULL,
+    };
+
+    emitterInit(&out.buf);
+    int ret = parseBlob(in, name, name, &dc->config, &out);
+    emitterFree(&out.buf);
+    if(sink.arena)
+        result->arena = sink.buf;
+
+    if(ret != 0)
+    {
+        diagConvRelease(result);
+        return DIAGCONV_ERR_NOMEM;
+    }
+
+    if(result->needed > sink.bufSize)
+        return DIAGCONV_ERR_SPACE;
+
+    for(int i = 0; i < 3; i++)
+        result->data[i] = sink.buf + sink.offset[i];
+
+    return DIAGCONV_OK;
+}
+
+/* Frees the memory of a result diagConvConvert() allocated, if any */
+void diagConvRelease(DIAGCONV_RESULT *result)
+{
+    free(result->arena);
+    result->arena = NULL;
+    for(int i = 0; i < 3; i++)
+        result->data[i] = NULL;
+}
+
+const char *diagConvStatusText(DIAGCONV_STATUS status)
+{
+    static const char *text[] = {
+        "OK",
+        "Invalid arguments",
+        "Not a .bin file (size)",
+        "Unknown file magic",
+        "No map entry",
+        "Buffer too small",
+        "Out of memory",
+        "Broken .bin file (offsets)",
+    };
+
+    return status < sizeof(text) / sizeof(text[0]) ? text[status] : "Unknown status";
+}
+
+int diagConvApiVersion(void)
+{
+    return DIAGCONV_API_VERSION;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * libdiagconv: In-memory conversion of .bin files, the stable C API
+ *
+ * Build with make lib (libdiagconv.a and libdiagconv.so). Nothing here touches the filesystem, except for loading
+ * a dictionary file when creating a context. A context is read-only after diagConvNew(), so any number of threads
+ * can convert with the same one at the same time.
+ *
+ * Compatibility: Only additions from here on. DIAGCONV_OPTIONS starts with its own size, so older callers keep
+ * working when fields get added to its end.
+ */
+#define DIAGCONV_API_VERSION 1
+
+#if defined(__GNUC__)
+#define DIAGCONV_EXPORT __attribute__((visibility("default")))
+#else
+#define DIAGCONV_EXPORT
+#endif
+
+typedef struct DIAGCONV DIAGCONV;
+
+/* What diagConvConvert() returns */
+typedef enum
+{
+    DIAGCONV_OK = 0,
+    DIAGCONV_ERR_ARGS, // NULL pointers, id over 24 bits, unknown options
+    DIAGCONV_ERR_SIZE, // The blob is too small or too big to be a .bin file
+    DIAGCONV_ERR_MAGIC, // Unknown file magic
+    DIAGCONV_ERR_UNMAPPED, // No output name for the id in the dictionary
+    DIAGCONV_ERR_SPACE, // The outputs don't fit into the buffer, DIAGCONV_RESULT.needed tells how much they need
+    DIAGCONV_ERR_NOMEM,
+    DIAGCONV_ERR_FORMAT, // Message lists or messages reach beyond the end of the blob
+} DIAGCONV_STATUS;
+
+typedef enum
+{
+    DIAGCONV_STRINGS_RAW = 0, // As in the game, RARE character table
+    DIAGCONV_STRINGS_ISO8859_1,
+    DIAGCONV_STRINGS_UTF8,
+} DIAGCONV_STRINGS;
+
+/* Control bytes in front of quiz answers */
+typedef enum
+{
+    DIAGCONV_CONTROL_NONE = 0,
+    DIAGCONV_CONTROL_ESCAPED, // "\xFDl"
+    DIAGCONV_CONTROL_BINARY,
+} DIAGCONV_CONTROL;
+
+typedef enum
+{
+    DIAGCONV_DIALOG = 0,
+    DIAGCONV_QUIZ,
+    DIAGCONV_GRUNTY,
+} DIAGCONV_TYPE;
+
+typedef struct
+{
+    size_t size; // sizeof(DIAGCONV_OPTIONS)
+    DIAGCONV_STRINGS strings;
+    DIAGCONV_CONTROL control;
+    const char *charset; // Character table of the game version, NULL for the default
+    const char *dictFile; // Dictionary file as written by diagConv --make-dict, NULL for the built-in one
+} DIAGCONV_OPTIONS;
+
+/*
+ * The rendered YAML files of one .bin file, one per language (English, French, German)
+ *
+ * data points into the buffer given to diagConvConvert() respectively into memory owned by the result.
+ * The files aren't null terminated.
+ */
+typedef struct
+{
+    DIAGCONV_TYPE type;
+    char language[3][3]; // "EN", "FR", "DE"
+    char path[3][32]; // Where diagConv would write them, "EN/dialog/0DA5.dialog" and so on
+    const char *data[3];
+    size_t size[3];
+    size_t needed; // Bytes needed for all three
+    void *arena; // Owned by the result if diagConvConvert() allocated it
+} DIAGCONV_RESULT;
+
+/* Creates a context, options may be NULL for raw strings and no control bytes. Returns NULL on errors */
+DIAGCONV_EXPORT DIAGCONV *diagConvNew(const DIAGCONV_OPTIONS *options);
+DIAGCONV_EXPORT void diagConvFree(DIAGCONV *dc);
+
+/*
+ * Converts a .bin file
+ *
+ * id is the 24 bit number from its name (0x5D8880 for 5D8880.bin). The outputs go into buf, if buf is NULL they
+ * go into memory allocated for the result which diagConvRelease() frees. The structure of the blob gets checked
+ * against size first, so a broken or hostile blob gives DIAGCONV_ERR_FORMAT and never makes the parser read beyond it.
+ */
+DIAGCONV_EXPORT DIAGCONV_STATUS diagConvConvert(const DIAGCONV *dc, const void *blob, size_t size, uint32_t id, void *buf, size_t bufSize,
+                                                DIAGCONV_RESULT *result);
+DIAGCONV_EXPORT void diagConvRelease(DIAGCONV_RESULT *result);
+DIAGCONV_EXPORT const char *diagConvStatusText(DIAGCONV_STATUS status);
+DIAGCONV_EXPORT int diagConvApiVersion(void);
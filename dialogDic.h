@@ -2,5 +2,5 @@
 
 #define DIAG_LIST_MAX 712
 
-extern char __attribute__ ((nonstring)) diagInList[DIAG_LIST_MAX][6];
-extern char __attribute__ ((nonstring)) diagOutList[DIAG_LIST_MAX][4];
+extern const char __attribute__ ((nonstring)) diagInList[DIAG_LIST_MAX][6];
+extern const char __attribute__ ((nonstring)) diagOutList[DIAG_LIST_MAX][4];
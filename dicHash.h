@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Minimal perfect hash over the dictionaries, generated at build time by tools/genDicHash.c
+ *
+ * The key is the 24-bit value of the hex filename, the value the 16-bit value of the hex output name.
+ * Each entry is packed as 3 key bytes followed by 2 value bytes (both little endian).
+ * Lookup: The key selects a bucket, the buckets displacement together with the key selects the entry.
+ */
+typedef struct
+{
+    const uint16_t *displace;
+    const uint8_t (*entries)[5];
+    uint32_t buckets;
+    uint32_t size;
+} DIC_HASH;
+
+extern const DIC_HASH diagHash;
+extern const DIC_HASH quizHash;
+extern const DIC_HASH gruntyHash;
+
+#define DIC_MISS -1
+
+static inline uint32_t dicBucket(const DIC_HASH *hash, uint32_t key)
+{
+    return ((uint64_t)(key * 0x9E3779B1u) * hash->buckets) >> 32;
+}
+
+static inline uint32_t dicSlot(const DIC_HASH *hash, uint32_t key, uint32_t displace)
+{
+    uint32_t x = (key * 0x85EBCA6Bu) ^ (displace * 0xC2B2AE35u);
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    return ((uint64_t)x * hash->size) >> 32;
+}
+
+/*
+ * Converts a 6 char hex filename to its 24-bit key
+ *
+ * Invalid characters set bits above bit 23, so the key will never match an entry
+ * (null terminator not counted nor needed as it reads 6 bytes only)
+ */
+static inline uint32_t dicKey(const char *name)
+{
+    uint32_t key = 0;
+    uint32_t bad = 0;
+    for(int i = 0; i < 6; i++)
+    {
+        uint32_t c = (unsigned char)name[i];
+        uint32_t v = c <= '9' ? c - '0' : c - 'A' + 10;
+        bad |= v;
+        key = (key << 4) | (v & 0x0F);
+    }
+
+    return key | ((bad & ~0x0Fu) ? 0x01000000u : 0);
+}
+
+/* Looks a key up, returns the value or DIC_MISS */
+static inline int32_t dicLookup(const DIC_HASH *hash, uint32_t key)
+{
+    const uint8_t *e = hash->entries[dicSlot(hash, key, hash->displace[dicBucket(hash, key)])];
+    uint32_t stored = e[0] | (e[1] << 8) | (e[2] << 16);
+    int32_t value = e[3] | (e[4] << 8);
+    return stored == key ? value : DIC_MISS;
+}
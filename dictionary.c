@@ -0,0 +1,260 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dictionary.h"
+
+/*
+ * FNV-1a over a single entry, used to tell dictionaries apart
+ *
+ * The checksum of a dictionary is the sum over its entries, so it doesn't depend on the order of the tables
+ */
+static uint32_t entryChecksum(DIC_TYPE type, uint32_t key, uint16_t value)
+{
+    uint8_t data[] = { type, key, key >> 8, key >> 16, value, value >> 8 };
+    uint32_t hash = 0x811C9DC5;
+    for(size_t i = 0; i < sizeof(data); i++)
+    {
+        hash ^= data[i];
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+/* Sets the dictionary up to use the compiled-in tables */
+void dictionaryInit(DICTIONARY *dic)
+{
+    memset(dic, 0, sizeof(DICTIONARY));
+    dic->hash[DIC_DIALOG] = &diagHash;
+    dic->hash[DIC_QUIZ] = &quizHash;
+    dic->hash[DIC_GRUNTY] = &gruntyHash;
+
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        for(uint32_t j = 0; j < dic->hash[i]->size; j++)
+        {
+            const uint8_t *e = dic->hash[i]->entries[j];
+            dic->checksum += entryChecksum(i, e[0] | (e[1] << 8) | (e[2] << 16), e[3] | (e[4] << 8));
+        }
+    }
+}
+
+/*
+ * Maps a dictionary file read-only
+ *
+ * The mapping is shared, so any number of processes can use the same file without copying it.
+ */
+bool dictionaryLoad(DICTIONARY *dic, const char *file)
+{
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+    {
+        fprintf(stderr, "Error opening %s: %s\n", file, strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(DICT_HEADER))
+    {
+        fprintf(stderr, "Sanity error (%s)\n", file);
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED)
+    {
+        fprintf(stderr, "Error mapping %s: %s\n", file, strerror(errno));
+        return false;
+    }
+
+    const DICT_HEADER *hdr = map;
+    size_t entries = 0;
+    for(int i = 0; i < DIC_TYPES; i++)
+        entries += hdr->count[i];
+
+    if(memcmp(hdr->magic, DICT_MAGIC, 4) != 0 || hdr->version != DICT_VERSION ||
+       entries > (size_t)st.st_size || sizeof(DICT_HEADER) + entries * (sizeof(uint32_t) + sizeof(uint16_t)) > (size_t)st.st_size)
+    {
+        fprintf(stderr, "Invalid dictionary file %s\n", file);
+        munmap(map, st.st_size);
+        return false;
+    }
+
+    // The lookup is a binary search, so the keys have to be sorted. The checksum has to match the entries, it's
+    // what tells incremental runs that the dictionary changed
+    const uint32_t *keys = (const uint32_t *)(hdr + 1);
+    const uint16_t *values = (const uint16_t *)(keys + entries);
+    uint32_t checksum = 0;
+    bool sorted = true;
+    for(size_t i = 0, n = 0; i < DIC_TYPES; i++)
+    {
+        for(uint32_t j = 0; j < hdr->count[i]; j++, n++)
+        {
+            sorted = sorted && keys[n] <= 0xFFFFFF && (j == 0 || keys[n - 1] < keys[n]);
+            checksum += entryChecksum(i, keys[n], values[n]);
+        }
+    }
+
+    if(!sorted || checksum != hdr->checksum)
+    {
+        fprintf(stderr, "Corrupt dictionary file %s (%s)\n", file, sorted ? "checksum mismatch" : "keys out of order or over 24 bits");
+        munmap(map, st.st_size);
+        return false;
+    }
+
+    memset(dic, 0, sizeof(DICTIONARY));
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        dic->keys[i] = keys;
+        dic->values[i] = values;
+        dic->count[i] = hdr->count[i];
+        keys += hdr->count[i];
+        values += hdr->count[i];
+    }
+
+    dic->checksum = checksum;
+    dic->map = map;
+    dic->mapSize = st.st_size;
+    return true;
+}
+
+void dictionaryUnload(DICTIONARY *dic)
+{
+    if(dic->map != NULL)
+        munmap(dic->map, dic->mapSize);
+
+    dictionaryInit(dic);
+}
+
+/* The n-th entry of a table, in no particular order */
+void dictionaryEntry(const DICTIONARY *dic, DIC_TYPE type, uint32_t n, uint32_t *key, uint16_t *value)
+{
+    if(dic->map)
+    {
+        *key = dic->keys[type][n];
+        *value = dic->values[type][n];
+        return;
+    }
+
+    const uint8_t *e = dic->hash[type]->entries[n];
+    *key = e[0] | (e[1] << 8) | (e[2] << 16);
+    *value = e[3] | (e[4] << 8);
+}
+
+uint32_t dictionarySize(const DICTIONARY *dic, DIC_TYPE type)
+{
+    return dic->map ? dic->count[type] : dic->hash[type]->size;
+}
+
+/*
+ * Builds the reverse mapping of a table, from the output name back to the .bin name
+ *
+ * Returns an array with the key + 1 for each of the 65536 values, 0 if no key maps to it. If more than one does
+ * the lowest key wins. The caller frees it, NULL if out of memory.
+ */
+uint32_t *dictionaryInvert(const DICTIONARY *dic, DIC_TYPE type)
+{
+    uint32_t *inverse = calloc(0x10000, sizeof(uint32_t));
+    if(inverse == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return NULL;
+    }
+
+    for(uint32_t i = 0; i < dictionarySize(dic, type); i++)
+    {
+        uint32_t key;
+        uint16_t value;
+        dictionaryEntry(dic, type, i, &key, &value);
+        if(inverse[value] == 0 || inverse[value] > key + 1)
+            inverse[value] = key + 1;
+    }
+
+    return inverse;
+}
+
+static int comparePairs(const void *a, const void *b)
+{
+    uint64_t pa = *(const uint64_t *)a;
+    uint64_t pb = *(const uint64_t *)b;
+    return (pa > pb) - (pa < pb);
+}
+
+/* Writes a dictionary file, see dictionary.h for the format */
+bool dictionaryWrite(const DICTIONARY *dic, const char *file)
+{
+    DICT_HEADER hdr = {
+        .magic = DICT_MAGIC,
+        .version = DICT_VERSION,
+        .reserved = 0,
+    };
+
+    size_t entries = 0;
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        hdr.count[i] = dictionarySize(dic, i);
+        entries += hdr.count[i];
+    }
+
+    // Collect the entries as (key << 16 | value) pairs so sorting by key keeps the value with it
+    uint64_t *pairs = malloc(sizeof(uint64_t) * entries);
+    uint32_t *keys = malloc(sizeof(uint32_t) * entries);
+    uint16_t *values = malloc(sizeof(uint16_t) * entries);
+    if(pairs == NULL || keys == NULL || values == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        free(pairs);
+        free(keys);
+        free(values);
+        return false;
+    }
+
+    size_t n = 0;
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        size_t start = n;
+        for(uint32_t j = 0; j < hdr.count[i]; j++, n++)
+        {
+            uint32_t key;
+            uint16_t value;
+            dictionaryEntry(dic, i, j, &key, &value);
+            pairs[n] = ((uint64_t)key << 16) | value;
+        }
+
+        qsort(pairs + start, n - start, sizeof(uint64_t), comparePairs);
+    }
+
+    hdr.checksum = dic->checksum;
+    for(size_t i = 0; i < entries; i++)
+    {
+        keys[i] = pairs[i] >> 16;
+        values[i] = pairs[i];
+    }
+
+    bool ret = false;
+    FILE *f = fopen(file, "wb");
+    if(f != NULL)
+    {
+        ret = fwrite(&hdr, sizeof(DICT_HEADER), 1, f) == 1 &&
+              fwrite(keys, sizeof(uint32_t), entries, f) == entries &&
+              fwrite(values, sizeof(uint16_t), entries, f) == entries;
+
+        ret = fclose(f) == 0 && ret;
+    }
+
+    if(!ret)
+        fprintf(stderr, "Error writing %s\n", file);
+
+    free(pairs);
+    free(keys);
+    free(values);
+    return ret;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dicHash.h"
+
+typedef enum
+{
+    DIC_DIALOG = 0,
+    DIC_QUIZ,
+    DIC_GRUNTY,
+    DIC_TYPES
+} DIC_TYPE;
+
+/*
+ * Binary dictionary file as written by --make-dict and loaded by --dict
+ *
+ * The header is followed by the keys of all tables (sorted, uint32_t each),
+ * followed by the values of all tables (uint16_t each), in DIC_TYPE order.
+ * All numbers are little endian.
+ */
+#define DICT_MAGIC "DCDI"
+#define DICT_VERSION 1
+
+typedef struct __attribute__((__packed__))
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t checksum;
+    uint32_t count[DIC_TYPES];
+} DICT_HEADER;
+
+/* Either the compiled-in hashes or a mmapped dictionary file */
+typedef struct
+{
+    const DIC_HASH *hash[DIC_TYPES];
+    const uint32_t *keys[DIC_TYPES];
+    const uint16_t *values[DIC_TYPES];
+    uint32_t count[DIC_TYPES];
+    uint32_t checksum;
+    void *map;
+    size_t mapSize;
+} DICTIONARY;
+
+void dictionaryInit(DICTIONARY *dic);
+bool dictionaryLoad(DICTIONARY *dic, const char *file);
+void dictionaryUnload(DICTIONARY *dic);
+uint32_t dictionarySize(const DICTIONARY *dic, DIC_TYPE type);
+void dictionaryEntry(const DICTIONARY *dic, DIC_TYPE type, uint32_t n, uint32_t *key, uint16_t *value);
+uint32_t *dictionaryInvert(const DICTIONARY *dic, DIC_TYPE type);
+bool dictionaryWrite(const DICTIONARY *dic, const char *file);
+
+/* Looks a key up, returns the value or DIC_MISS */
+static inline int32_t dictionaryLookup(const DICTIONARY *dic, DIC_TYPE type, uint32_t key)
+{
+    if(dic->map == NULL)
+        return dicLookup(dic->hash[type], key);
+
+    // Branchless binary search, the compiler turns the inner condition into a cmov
+    const uint32_t *base = dic->keys[type];
+    uint32_t len = dic->count[type];
+    if(len == 0)
+        return DIC_MISS;
+
+    while(len > 1)
+    {
+        uint32_t half = len / 2;
+        base = base[half] <= key ? base + half : base;
+        len -= half;
+    }
+
+    return *base == key ? dic->values[type][base - dic->keys[type]] : DIC_MISS;
+}
@@ -0,0 +1,118 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "emitter.h"
+
+// Two uppercase hex digits for each byte value
+static const char hexTable[256 * 2] =
+    "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+void emitterInit(EMITTER *e)
+{
+    e->data = NULL;
+    e->size = 0;
+    e->capacity = 0;
+}
+
+void emitterFree(EMITTER *e)
+{
+    free(e->data);
+    emitterInit(e);
+}
+
+/* Makes room for at least needed more bytes */
+bool emitterGrow(EMITTER *e, size_t needed)
+{
+    size_t capacity = e->capacity ? e->capacity : 4096;
+    while(capacity < e->size + needed)
+        capacity *= 2;
+
+    char *data = realloc(e->data, capacity);
+    if(data == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return false;
+    }
+
+    e->data = data;
+    e->capacity = capacity;
+    return true;
+}
+
+/* Writes the whole buffer to fd */
+bool emitterFlush(const EMITTER *e, int fd)
+{
+    const char *data = e->data;
+    size_t left = e->size;
+    while(left)
+    {
+        ssize_t written = write(fd, data, left);
+        if(written == -1)
+        {
+            if(errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        data += written;
+        left -= written;
+    }
+
+    return true;
+}
+
+/*
+ * Starts a single message line: '  - { cmd: 0xXX, string: "<prefix>'
+ *
+ * Reserves room for a string of up to maxLength bytes plus the tail and returns where the string goes, NULL if out of memory.
+ * The caller writes the string there directly and finishes the line with emitMessageEnd().
+ */
+char *emitMessageBegin(EMITTER *e, uint8_t cmd, const char *prefix, size_t prefixLength, size_t maxLength)
+{
+    size_t needed = sizeof(MESSAGE_HEAD MESSAGE_STRING MESSAGE_TAIL) - 1 + 2 + prefixLength + maxLength;
+    if(e->size + needed > e->capacity && !emitterGrow(e, needed))
+        return NULL;
+
+    char *out = e->data + e->size;
+    memcpy(out, MESSAGE_HEAD, sizeof(MESSAGE_HEAD) - 1);
+    out += sizeof(MESSAGE_HEAD) - 1;
+    memcpy(out, hexTable + cmd * 2, 2);
+    out += 2;
+    memcpy(out, MESSAGE_STRING, sizeof(MESSAGE_STRING) - 1);
+    out += sizeof(MESSAGE_STRING) - 1;
+    memcpy(out, prefix, prefixLength);
+    return out + prefixLength;
+}
+
+/* Finishes a message line whose string ends at end */
+void emitMessageEnd(EMITTER *e, char *end)
+{
+    memcpy(end, MESSAGE_TAIL, sizeof(MESSAGE_TAIL) - 1);
+    e->size = end + sizeof(MESSAGE_TAIL) - 1 - e->data;
+}
+
+/*
+ * Emits a single message line: '  - { cmd: 0xXX, string: "<prefix><msg>" }'
+ *
+ * The lengths are known by the caller, so this does no formatting nor string scanning
+ */
+bool emitMessage(EMITTER *e, uint8_t cmd, const char *prefix, size_t prefixLength, const char *msg, size_t length)
+{
+    char *out = emitMessageBegin(e, cmd, prefix, prefixLength, length);
+    if(out == NULL)
+        return false;
+
+    memcpy(out, msg, length);
+    emitMessageEnd(e, out + length);
+    return true;
+}
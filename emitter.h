@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Output buffer for the YAML files
+ *
+ * Each worker owns one. A file gets rendered into it completely and is then written out with a single write().
+ */
+typedef struct
+{
+    char *data;
+    size_t size;
+    size_t capacity;
+} EMITTER;
+
+/* The parts of a message line, the reverse encoder reads the same format */
+#define MESSAGE_HEAD "  - { cmd: 0x"
+#define MESSAGE_STRING ", string: \""
+#define MESSAGE_TAIL "\" }\n"
+
+void emitterInit(EMITTER *e);
+void emitterFree(EMITTER *e);
+bool emitterGrow(EMITTER *e, size_t needed);
+bool emitterFlush(const EMITTER *e, int fd);
+char *emitMessageBegin(EMITTER *e, uint8_t cmd, const char *prefix, size_t prefixLength, size_t maxLength);
+void emitMessageEnd(EMITTER *e, char *end);
+bool emitMessage(EMITTER *e, uint8_t cmd, const char *prefix, size_t prefixLength, const char *msg, size_t length);
+
+static inline void emitterReset(EMITTER *e)
+{
+    e->size = 0;
+}
+
+static inline bool emitRaw(EMITTER *e, const char *data, size_t length)
+{
+    if(e->size + length > e->capacity && !emitterGrow(e, length))
+        return false;
+
+    memcpy(e->data + e->size, data, length);
+    e->size += length;
+    return true;
+}
+
+/* Emits a string literal, its length is known at compile time */
+#define emitLiteral(e, str) emitRaw(e, str, sizeof(str) - 1)
@@ -0,0 +1,497 @@
+#define _GNU_SOURCE // memmem()
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "encode.h"
+#include "workerPool.h"
+
+/* Single pass reader over a mapped YAML file */
+typedef struct
+{
+    const char *pos;
+    const char *end;
+    const char *file; // For error messages
+} READER;
+
+/* The .dialog/.quiz_q/.grunty_q files found in the input folder, shared by all workers */
+typedef struct
+{
+    const char *path;
+    size_t pathLength;
+    const CONFIG *config;
+    struct
+    {
+        DIC_TYPE type;
+        uint16_t name;
+    } *jobs;
+    size_t count;
+    uint32_t *inverse[DIC_TYPES]; // See dictionaryInvert()
+} ENCODE_LIST;
+
+/* Per worker state */
+typedef struct
+{
+    const ENCODE_LIST *list;
+    EMITTER out;
+} ENCODER;
+
+/* Skips str if the input continues with it */
+static bool accept(READER *r, const char *str, size_t length)
+{
+    if((size_t)(r->end - r->pos) < length || memcmp(r->pos, str, length) != 0)
+        return false;
+
+    r->pos += length;
+    return true;
+}
+
+#define acceptLiteral(r, str) accept(r, str, sizeof(str) - 1)
+
+/* Checks if a message line, a section header or the end of the file starts at pos */
+static bool lineStart(const READER *r, const char *pos)
+{
+    size_t left = r->end - pos;
+    return left == 0 ||
+           (left >= sizeof(MESSAGE_HEAD) - 1 && memcmp(pos, MESSAGE_HEAD, sizeof(MESSAGE_HEAD) - 1) == 0) ||
+           (left >= sizeof("top:\n") - 1 && memcmp(pos, "top:\n", sizeof("top:\n") - 1) == 0) ||
+           (left >= sizeof("options:\n") - 1 && memcmp(pos, "options:\n", sizeof("options:\n") - 1) == 0);
+}
+
+static int hexDigit(char c)
+{
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+
+    return -1;
+}
+
+/*
+ * Reads a message line: '  - { cmd: 0xXX, string: "<string>" }'
+ *
+ * Strings aren't escaped, so one ends at the first '" }' followed by the end of the line and the start of the next one.
+ * Returns 1 for a message, 0 if there's none at the current position and -1 on error.
+ */
+static int readMessage(READER *r, uint8_t *cmd, const char **str, size_t *length)
+{
+    if(!acceptLiteral(r, MESSAGE_HEAD))
+        return 0;
+
+    int high, low;
+    if(r->end - r->pos < 2 || (high = hexDigit(r->pos[0])) == -1 || (low = hexDigit(r->pos[1])) == -1)
+    {
+        fprintf(stderr, "Invalid cmd in %s\n", r->file);
+        return -1;
+    }
+
+    r->pos += 2;
+    if(!acceptLiteral(r, MESSAGE_STRING))
+    {
+        fprintf(stderr, "Expected a string in %s\n", r->file);
+        return -1;
+    }
+
+    for(const char *s = r->pos; s < r->end; s++)
+    {
+        s = memmem(s, r->end - s, MESSAGE_TAIL, sizeof(MESSAGE_TAIL) - 2);
+        if(s == NULL)
+            break;
+
+        // The newline after the last line is optional
+        const char *next = s + sizeof(MESSAGE_TAIL) - 2;
+        if(next != r->end && (*next != '\n' || !lineStart(r, ++next)))
+            continue;
+
+        *cmd = high << 4 | low;
+        *str = r->pos;
+        *length = s - r->pos;
+        r->pos = next;
+        return 1;
+    }
+
+    fprintf(stderr, "Unterminated string in %s\n", r->file);
+    return -1;
+}
+
+/* Appends a message, transcoding its string back if it's text. The string can't get longer on the way */
+static bool encodeMessage(EMITTER *out, uint8_t cmd, const char *str, size_t length, bool transform, const CONFIG *config, const char *file)
+{
+    if(out->size + length + 3 > out->capacity && !emitterGrow(out, length + 3))
+        return false;
+
+    uint8_t *m = (uint8_t *)out->data + out->size;
+    const uint8_t *src = (const uint8_t *)str;
+    size_t n = length;
+    if(!transform || !(config->convert & (TO_ISO | TO_UTF)))
+        memcpy(m + 2, src, length);
+    else if(config->convert & TO_ISO)
+        n = charsetFromIso(config->charset, src, length, m + 2, length);
+    else
+        n = charsetFromUtf8(config->charset, src, length, m + 2, length);
+
+    // The length counts the null terminator
+    if(n + 1 > UINT8_MAX)
+    {
+        fprintf(stderr, "String too long in %s\n", file);
+        return false;
+    }
+
+    m[0] = cmd;
+    m[1] = n + 1;
+    m[2 + n] = '\0';
+    out->size += n + 3;
+    return true;
+}
+
+/* What the parsers do with the messages of a section */
+typedef enum
+{
+    SECTION_BOTTOM, // Dialog bottom messages, see dialogTransform()
+    SECTION_TOP, // Dialog top messages, text if the high bit is set
+    SECTION_QUESTION, // Always text
+    SECTION_OPTIONS, // Always text, with the control bytes in front if there are any
+} SECTION;
+
+/* Encodes the messages up to the next section header or the end of the file, adding them to *count */
+static bool encodeSection(READER *r, EMITTER *out, SECTION section, unsigned int *count, const CONFIG *config)
+{
+    const char *prefix = "";
+    size_t prefixLength = 0;
+    if(section == SECTION_OPTIONS && config->convert & TO_CON)
+    {
+        prefix = config->convert & TO_COM ? ANSWER_PREFIX : ANSWER_PREFIX_ESCAPED;
+        prefixLength = strlen(prefix);
+    }
+
+    bool special = false;
+    uint8_t cmd;
+    const char *str;
+    size_t length;
+    int ret;
+    while((ret = readMessage(r, &cmd, &str, &length)) == 1)
+    {
+        if(++*count > UINT8_MAX)
+        {
+            fprintf(stderr, "Too many messages in %s\n", r->file);
+            return false;
+        }
+
+        if(length >= prefixLength && memcmp(str, prefix, prefixLength) == 0)
+        {
+            str += prefixLength;
+            length -= prefixLength;
+        }
+
+        bool transform = true;
+        if(section == SECTION_BOTTOM)
+            transform = dialogTransform(cmd, &special);
+        else if(section == SECTION_TOP)
+            transform = cmd & 0x80;
+
+        if(!encodeMessage(out, cmd, str, length, transform, config, r->file))
+            return false;
+    }
+
+    return ret == 0;
+}
+
+/* Emits a message list: Its count, followed by the messages of the given sections */
+static bool encodeList(READER *r, EMITTER *out, SECTION section, const char *nextHeader, size_t nextHeaderLength, const CONFIG *config)
+{
+    size_t countPos = out->size;
+    unsigned int count = 0;
+    if(!emitRaw(out, "", 1) || !encodeSection(r, out, section, &count, config))
+        return false;
+
+    // Quizzes have the options in the same list
+    if(nextHeader != NULL && accept(r, nextHeader, nextHeaderLength) && !encodeSection(r, out, SECTION_OPTIONS, &count, config))
+        return false;
+
+    out->data[countPos] = count;
+    return true;
+}
+
+/*
+ * Encodes the three languages of a file into out
+ *
+ * The layout is the one parseDialog() and parseQuiz() read: A header with the offsets of the languages,
+ * each language is a message count followed by the messages, dialogs have a second list for the top messages.
+ */
+bool encodeFile(DIC_TYPE type, const char *const yaml[3], const size_t size[3], const char *const file[3], const CONFIG *config, EMITTER *out)
+{
+    // Dialogs start with 0x03, quizzes with 0x03 0x01 (0x03 0x03 for Grunty) and a byte of unknown meaning, written as 0x00
+    emitterReset(out);
+    bool ok;
+    if(type == DIC_DIALOG)
+        ok = emitRaw(out, "\x03", 1);
+    else
+        ok = emitRaw(out, type == DIC_GRUNTY ? "\x03\x03\x00" : "\x03\x01\x00", 3);
+
+    size_t offsets = out->size;
+    ok = ok && emitRaw(out, "\0\0\0\0\0\0", 6);
+    for(int i = 0; ok && i < 3; i++)
+    {
+        out->data[offsets + i * 2] = out->size;
+        out->data[offsets + i * 2 + 1] = out->size >> 8;
+
+        READER r = { .pos = yaml[i], .end = yaml[i] + size[i], .file = file[i] };
+        if(type == DIC_DIALOG)
+        {
+            if(!acceptLiteral(&r, "type: Dialog\nbottom:\n"))
+            {
+                fprintf(stderr, "%s is no dialog\n", file[i]);
+                return false;
+            }
+
+            ok = encodeList(&r, out, SECTION_BOTTOM, NULL, 0, config);
+            if(ok && !acceptLiteral(&r, "top:\n"))
+            {
+                fprintf(stderr, "Missing top section in %s\n", file[i]);
+                return false;
+            }
+
+            ok = ok && encodeList(&r, out, SECTION_TOP, NULL, 0, config);
+        }
+        else
+        {
+            if(!acceptLiteral(&r, "type: QuizQuestion\nquestion:\n"))
+            {
+                fprintf(stderr, "%s is no quiz question\n", file[i]);
+                return false;
+            }
+
+            ok = encodeList(&r, out, SECTION_QUESTION, "options:\n", sizeof("options:\n") - 1, config);
+        }
+
+        if(ok && r.pos != r.end)
+        {
+            fprintf(stderr, "Unexpected content in %s\n", file[i]);
+            return false;
+        }
+    }
+
+    // Offsets are 16 bit, but the parsers only take files up to INPUT_MAX anyway
+    if(ok && out->size >= INPUT_MAX)
+    {
+        fprintf(stderr, "%s is too big for a .bin file\n", file[0]);
+        return false;
+    }
+
+    return ok;
+}
+
+/* Maps a file read-only, empty files get a NULL mapping */
+static bool mapFile(const char *file, const char **data, size_t *size)
+{
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+    {
+        fprintf(stderr, "%s not found\n", file);
+        return false;
+    }
+
+    struct stat st;
+    bool ret = fstat(fd, &st) == 0;
+    *size = ret ? st.st_size : 0;
+    *data = NULL;
+    if(ret && *size != 0)
+    {
+        void *map = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map == MAP_FAILED)
+            ret = false;
+        else
+            *data = map;
+    }
+
+    if(!ret)
+        fprintf(stderr, "I/O error: %s (%u)\n", strerror(errno), errno);
+
+    close(fd);
+    return ret;
+}
+
+/*
+ * Worker job: Encodes the n-th file of the list
+ *
+ * Reads XX/<type>/NNNN.<type> for all three languages below the input folder and writes the .bin file to the current folder.
+ */
+static int encodeJob(void *ctx, size_t n)
+{
+    ENCODER *encoder = ctx;
+    const ENCODE_LIST *list = encoder->list;
+    DIC_TYPE type = list->jobs[n].type;
+    uint16_t name = list->jobs[n].name;
+    uint32_t key = list->inverse[type][name];
+    if(key-- == 0)
+    {
+        fprintf(stderr, "No map entry for %s %04X.%s\n", typeDir[type], name, typeDir[type]);
+        return 0;
+    }
+
+    // .bin names have 6 hex digits, a hand-made dictionary could have bigger keys
+    if(key > 0xFFFFFF)
+    {
+        fprintf(stderr, "Map entry %X for %s %04X.%s is no .bin name\n", key, typeDir[type], name, typeDir[type]);
+        return 1;
+    }
+
+    char file[3][list->pathLength + sizeof("XX/grunty_q/XXXX.grunty_q")];
+    const char *files[3];
+    const char *yaml[3] = { NULL };
+    size_t size[3] = { 0 };
+    bool ok = true;
+    for(int i = 0; ok && i < 3; i++)
+    {
+        snprintf(file[i], sizeof(file[i]), "%s%s/%s/%04X.%s", list->path, lang[i], typeDir[type], name, typeDir[type]);
+        files[i] = file[i];
+        ok = mapFile(file[i], yaml + i, size + i);
+    }
+
+    ok = ok && encodeFile(type, yaml, size, files, list->config, &encoder->out);
+    for(int i = 0; i < 3; i++)
+        if(yaml[i] != NULL)
+            munmap((void *)yaml[i], size[i]);
+
+    if(!ok)
+        return 1;
+
+    char bin[sizeof("XXXXXX.bin")];
+    snprintf(bin, sizeof(bin), "%06X.bin", key & 0xFFFFFF);
+    int fd = open(bin, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if(fd == -1)
+    {
+        fprintf(stderr, "Error opening %s\n", bin);
+        return 1;
+    }
+
+    ok = emitterFlush(&encoder->out, fd);
+    if(close(fd) == -1)
+        ok = false;
+
+    if(!ok)
+    {
+        fprintf(stderr, "Error writing %s\n", bin);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Collects the NNNN.<type> files of the first language, the others have to have the same */
+static bool collectFiles(ENCODE_LIST *list, DIC_TYPE type, size_t *capacity)
+{
+    char dirPath[list->pathLength + sizeof("XX/grunty_q")];
+    snprintf(dirPath, sizeof(dirPath), "%s%s/%s", list->path, lang[0], typeDir[type]);
+    DIR *dir = opendir(dirPath);
+    if(dir == NULL)
+        return errno == ENOENT;
+
+    size_t el = strlen(typeDir[type]);
+    struct dirent *entry;
+    bool ret = true;
+    while((entry = readdir(dir)) != NULL)
+    {
+        const char *n = entry->d_name;
+        if(entry->d_type != DT_REG || strlen(n) != 4 + 1 + el || n[4] != '.' || memcmp(n + 5, typeDir[type], el) != 0)
+            continue;
+
+        int value = 0;
+        for(int i = 0; i < 4 && value != -1; i++)
+        {
+            int d = hexDigit(n[i]);
+            value = d == -1 ? -1 : value << 4 | d;
+        }
+
+        if(value == -1)
+            continue;
+
+        if(list->count == *capacity)
+        {
+            *capacity = *capacity ? *capacity * 2 : 1024;
+            void *jobs = realloc(list->jobs, *capacity * sizeof(*list->jobs));
+            if(jobs == NULL)
+            {
+                fprintf(stderr, "Out of memory\n");
+                ret = false;
+                break;
+            }
+
+            list->jobs = jobs;
+        }
+
+        list->jobs[list->count].type = type;
+        list->jobs[list->count++].name = value;
+    }
+
+    closedir(dir);
+    return ret;
+}
+
+/*
+ * Encodes all files below path (the folder containing EN, FR and DE) back to .bin files in the current folder
+ *
+ * The dictionary is used the other way around, see dictionaryInvert().
+ */
+int encodeRun(const char *path, const CONFIG *config, unsigned int threads)
+{
+    size_t pl = strlen(path);
+    char dirPath[pl + 2];
+    memcpy(dirPath, path, pl);
+    memcpy(dirPath + pl, "/", 2);
+
+    ENCODE_LIST list = {
+        .path = dirPath,
+        .pathLength = pl + 1,
+        .config = config,
+        .jobs = NULL,
+        .count = 0,
+    };
+
+    int ret = 0;
+    size_t capacity = 0;
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        list.inverse[i] = dictionaryInvert(config->dic, i);
+        if(list.inverse[i] == NULL || !collectFiles(&list, i, &capacity))
+            ret = 1;
+    }
+
+    ENCODER *encoders = ret == 0 ? malloc(sizeof(ENCODER) * threads) : NULL;
+    if(encoders != NULL)
+    {
+        for(unsigned int i = 0; i < threads; i++)
+        {
+            encoders[i].list = &list;
+            emitterInit(&encoders[i].out);
+        }
+
+        ret = poolRun(list.count, threads, encodeJob, encoders, sizeof(ENCODER));
+
+        for(unsigned int i = 0; i < threads; i++)
+            emitterFree(&encoders[i].out);
+
+        free(encoders);
+    }
+    else if(ret == 0)
+    {
+        fprintf(stderr, "Out of memory\n");
+        ret = 1;
+    }
+
+    for(int i = 0; i < DIC_TYPES; i++)
+        free(list.inverse[i]);
+
+    free(list.jobs);
+    return ret;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "convert.h"
+#include "emitter.h"
+
+/*
+ * Reverse direction: Turns the YAML files written by the parsers back into .bin files
+ *
+ * The YAML files have to be in the format the parsers write, this is no general YAML parser.
+ * config has to have the same settings as the run which created them.
+ */
+bool encodeFile(DIC_TYPE type, const char *const yaml[3], const size_t size[3], const char *const file[3], const CONFIG *config, EMITTER *out);
+int encodeRun(const char *path, const CONFIG *config, unsigned int threads);
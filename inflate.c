@@ -0,0 +1,376 @@
+#include <pthread.h>
+#include <string.h>
+
+#include "inflate.h"
+
+#define MAX_BITS 15
+#define MAX_LENGTH_CODES 286
+#define MAX_DIST_CODES 30
+#define FIXED_LENGTH_CODES 288
+#define FAST_BITS 9
+
+typedef struct
+{
+    const uint8_t *in;
+    size_t inSize;
+    size_t inPos;
+    uint8_t *out;
+    size_t outSize;
+    size_t outPos;
+    uint32_t bitBuf;
+    int bitCount;
+    bool error; // Ran out of input, everything read after that is 0
+} STATE;
+
+/*
+ * Canonical Huffman code: The number of codes of each length and the symbols ordered by code
+ *
+ * fast resolves all codes up to FAST_BITS long with a single lookup of the next bits, the entries are
+ * symbol << 4 | length. Longer codes have no entry (0) and get decoded bit by bit.
+ */
+typedef struct
+{
+    uint16_t count[MAX_BITS + 1];
+    uint16_t symbol[FIXED_LENGTH_CODES];
+    uint16_t fast[1 << FAST_BITS];
+} HUFFMAN;
+
+static const uint16_t lengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t lengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t distBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+static const uint8_t distExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* Takes need bits, LSB first */
+static uint32_t bits(STATE *s, int need)
+{
+    while(s->bitCount < need)
+    {
+        if(s->inPos == s->inSize)
+        {
+            s->error = true;
+            return 0;
+        }
+
+        s->bitBuf |= (uint32_t)s->in[s->inPos++] << s->bitCount;
+        s->bitCount += 8;
+    }
+
+    uint32_t ret = s->bitBuf & ((1u << need) - 1);
+    s->bitBuf >>= need;
+    s->bitCount -= need;
+    return ret;
+}
+
+/* Decodes a symbol, -1 if the code is invalid */
+static int decode(STATE *s, const HUFFMAN *h)
+{
+    while(s->bitCount < FAST_BITS && s->inPos < s->inSize)
+    {
+        s->bitBuf |= (uint32_t)s->in[s->inPos++] << s->bitCount;
+        s->bitCount += 8;
+    }
+
+    // The bits above bitCount are 0, so near the end of the input this still finds the short codes
+    uint16_t entry = h->fast[s->bitBuf & ((1 << FAST_BITS) - 1)];
+    if(entry != 0 && (entry & 15) <= s->bitCount)
+    {
+        s->bitBuf >>= entry & 15;
+        s->bitCount -= entry & 15;
+        return entry >> 4;
+    }
+
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for(int len = 1; len <= MAX_BITS; len++)
+    {
+        code |= bits(s, 1);
+        int count = h->count[len];
+        if(code - count < first)
+            return h->symbol[index + (code - first)];
+
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+/* Builds a code from the code lengths. Returns 0 if complete, > 0 if incomplete and < 0 if oversubscribed */
+static int construct(HUFFMAN *h, const uint16_t *length, int n)
+{
+    memset(h->count, 0, sizeof(h->count));
+    memset(h->fast, 0, sizeof(h->fast));
+    for(int i = 0; i < n; i++)
+        h->count[length[i]]++;
+
+    if(h->count[0] == n)
+        return 0;
+
+    int left = 1;
+    for(int len = 1; len <= MAX_BITS; len++)
+    {
+        left = (left << 1) - h->count[len];
+        if(left < 0)
+            return left;
+    }
+
+    uint16_t offsets[MAX_BITS + 1];
+    offsets[1] = 0;
+    for(int len = 1; len < MAX_BITS; len++)
+        offsets[len + 1] = offsets[len] + h->count[len];
+
+    for(int i = 0; i < n; i++)
+        if(length[i] != 0)
+            h->symbol[offsets[length[i]]++] = i;
+
+    // The codes are stored MSB first, so the table gets indexed by the reversed code
+    int code = 0;
+    int index = 0;
+    for(int len = 1; len <= FAST_BITS; len++)
+    {
+        for(int i = 0; i < h->count[len]; i++, code++)
+        {
+            int reversed = 0;
+            for(int bit = 0; bit < len; bit++)
+                reversed |= ((code >> bit) & 1) << (len - 1 - bit);
+
+            for(; reversed < 1 << FAST_BITS; reversed += 1 << len)
+                h->fast[reversed] = h->symbol[index + i] << 4 | len;
+        }
+
+        index += h->count[len];
+        code <<= 1;
+    }
+
+    return left;
+}
+
+static bool stored(STATE *s)
+{
+    // Back to the byte boundary, whole bytes decode() fetched ahead go back to the input
+    s->inPos -= s->bitCount >> 3;
+    s->bitBuf = 0;
+    s->bitCount = 0;
+    if(s->inSize - s->inPos < 4)
+        return false;
+
+    uint16_t len = s->in[s->inPos] | (s->in[s->inPos + 1] << 8);
+    uint16_t nlen = s->in[s->inPos + 2] | (s->in[s->inPos + 3] << 8);
+    s->inPos += 4;
+    if((len ^ nlen) != 0xFFFF || s->inSize - s->inPos < len || s->outSize - s->outPos < len)
+        return false;
+
+    memcpy(s->out + s->outPos, s->in + s->inPos, len);
+    s->inPos += len;
+    s->outPos += len;
+    return true;
+}
+
+static bool codes(STATE *s, const HUFFMAN *lengthCode, const HUFFMAN *distCode)
+{
+    while(true)
+    {
+        int symbol = decode(s, lengthCode);
+        if(symbol < 0 || s->error)
+            return false;
+
+        if(symbol < 256)
+        {
+            if(s->outPos == s->outSize)
+                return false;
+
+            s->out[s->outPos++] = symbol;
+            continue;
+        }
+
+        if(symbol == 256)
+            return true;
+
+        symbol -= 257;
+        if(symbol >= 29)
+            return false;
+
+        size_t len = lengthBase[symbol] + bits(s, lengthExtra[symbol]);
+        symbol = decode(s, distCode);
+        if(symbol < 0 || symbol >= 30)
+            return false;
+
+        size_t dist = distBase[symbol] + bits(s, distExtra[symbol]);
+        if(s->error || dist > s->outPos || len > s->outSize - s->outPos)
+            return false;
+
+        // Byte by byte, the copy may overlap what it writes
+        for(size_t i = 0; i < len; i++)
+            s->out[s->outPos + i] = s->out[s->outPos + i - dist];
+
+        s->outPos += len;
+    }
+}
+
+/* The codes of fixed blocks, built once by buildFixed() */
+static HUFFMAN fixedLengthCode;
+static HUFFMAN fixedDistCode;
+static pthread_once_t fixedOnce = PTHREAD_ONCE_INIT;
+
+static void buildFixed()
+{
+    uint16_t length[FIXED_LENGTH_CODES];
+    int i = 0;
+    for(; i < 144; i++)
+        length[i] = 8;
+    for(; i < 256; i++)
+        length[i] = 9;
+    for(; i < 280; i++)
+        length[i] = 7;
+    for(; i < FIXED_LENGTH_CODES; i++)
+        length[i] = 8;
+
+    construct(&fixedLengthCode, length, FIXED_LENGTH_CODES);
+    for(i = 0; i < MAX_DIST_CODES; i++)
+        length[i] = 5;
+
+    construct(&fixedDistCode, length, MAX_DIST_CODES);
+}
+
+static bool fixed(STATE *s)
+{
+    pthread_once(&fixedOnce, buildFixed);
+    return codes(s, &fixedLengthCode, &fixedDistCode);
+}
+
+static bool dynamic(STATE *s)
+{
+    static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    int nlen = bits(s, 5) + 257;
+    int ndist = bits(s, 5) + 1;
+    int ncode = bits(s, 4) + 4;
+    if(s->error || nlen > MAX_LENGTH_CODES || ndist > MAX_DIST_CODES)
+        return false;
+
+    uint16_t length[MAX_LENGTH_CODES + MAX_DIST_CODES];
+    int i = 0;
+    for(; i < ncode; i++)
+        length[order[i]] = bits(s, 3);
+    for(; i < 19; i++)
+        length[order[i]] = 0;
+
+    HUFFMAN lengthCode, distCode;
+    if(construct(&lengthCode, length, 19) != 0)
+        return false;
+
+    // The code lengths of both codes, run length encoded
+    for(i = 0; i < nlen + ndist; )
+    {
+        int symbol = decode(s, &lengthCode);
+        if(symbol < 0 || s->error)
+            return false;
+
+        if(symbol < 16)
+        {
+            length[i++] = symbol;
+            continue;
+        }
+
+        uint16_t value = 0;
+        int repeat;
+        if(symbol == 16)
+        {
+            if(i == 0)
+                return false;
+
+            value = length[i - 1];
+            repeat = 3 + bits(s, 2);
+        }
+        else if(symbol == 17)
+            repeat = 3 + bits(s, 3);
+        else
+            repeat = 11 + bits(s, 7);
+
+        if(i + repeat > nlen + ndist)
+            return false;
+
+        while(repeat--)
+            length[i++] = value;
+    }
+
+    // Without an end of block code nothing could ever end
+    if(length[256] == 0)
+        return false;
+
+    // Incomplete codes are only fine with a single code
+    int left = construct(&lengthCode, length, nlen);
+    if(left < 0 || (left > 0 && nlen - lengthCode.count[0] != 1))
+        return false;
+
+    left = construct(&distCode, length + nlen, ndist);
+    if(left < 0 || (left > 0 && ndist - distCode.count[0] != 1))
+        return false;
+
+    return codes(s, &lengthCode, &distCode);
+}
+
+/* Inflates a raw deflate stream into out, returns the unpacked size or -1 if it's broken or doesn't fit */
+ssize_t inflateBlock(const uint8_t *in, size_t inSize, uint8_t *out, size_t outSize)
+{
+    STATE s = {
+        .in = in,
+        .inSize = inSize,
+        .inPos = 0,
+        .out = out,
+        .outSize = outSize,
+        .outPos = 0,
+        .bitBuf = 0,
+        .bitCount = 0,
+        .error = false,
+    };
+
+    bool last;
+    bool ok;
+    do
+    {
+        last = bits(&s, 1);
+        switch(bits(&s, 2))
+        {
+            case 0:
+                ok = stored(&s);
+                break;
+            case 1:
+                ok = fixed(&s);
+                break;
+            case 2:
+                ok = dynamic(&s);
+                break;
+            default:
+                ok = false;
+                break;
+        }
+    }
+    while(ok && !last && !s.error);
+
+    return ok && !s.error ? (ssize_t)s.outPos : -1;
+}
+
+/* Inflates an asset with Rare-zip header, the unpacked size has to match the one in the header */
+ssize_t inflateRareZip(const uint8_t *in, size_t inSize, uint8_t *out, size_t outSize)
+{
+    if(!isRareZip(in, inSize))
+        return -1;
+
+    uint32_t size = ((uint32_t)in[2] << 24) | (in[3] << 16) | (in[4] << 8) | in[5];
+    if(size > outSize)
+        return -1;
+
+    ssize_t ret = inflateBlock(in + RAREZIP_HEADER_SIZE, inSize - RAREZIP_HEADER_SIZE, out, size);
+    return ret == (ssize_t)size ? ret : -1;
+}
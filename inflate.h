@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/*
+ * Decompression of the compressed assets of the game, for --inflate
+ *
+ * The assets are raw deflate streams (RFC 1951), in the ROM with a Rare-zip header in front: 0x11 0x72 and the
+ * unpacked size as 32 bit big endian number. Both decode straight into a caller buffer, nothing gets allocated, so
+ * any number of workers can inflate at the same time.
+ */
+#define RAREZIP_MAGIC0 0x11
+#define RAREZIP_MAGIC1 0x72
+#define RAREZIP_HEADER_SIZE 6
+
+ssize_t inflateBlock(const uint8_t *in, size_t inSize, uint8_t *out, size_t outSize);
+ssize_t inflateRareZip(const uint8_t *in, size_t inSize, uint8_t *out, size_t outSize);
+
+static inline bool isRareZip(const uint8_t *in, size_t inSize)
+{
+    return inSize >= RAREZIP_HEADER_SIZE && in[0] == RAREZIP_MAGIC0 && in[1] == RAREZIP_MAGIC1;
+}
@@ -0,0 +1,417 @@
+/*
+ * Batched io_uring I/O backend
+ *
+ * Each worker owns a ring and processes the input files in batches of up to depth files:
+ * 1. Queue an openat -> read -> close chain for every input of the batch and wait for all of them.
+ * 2. Parse the inputs. The parsers output gets stashed instead of written.
+ * 3. Queue an openat -> write -> close chain for every stashed output file and wait for all of them.
+ * The chains use direct descriptors, so a whole chain needs no round trip to userspace.
+ */
+
+#ifdef HAVE_IO_URING
+
+#include <errno.h>
+#include <fcntl.h>
+#include <liburing.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ioUring.h"
+#include "probes.h"
+#include "workerPool.h"
+
+#define OP_OPEN 0
+#define OP_IO 1
+#define OP_CLOSE 2
+
+// The input file of a slot uses this file index in the tag
+#define INPUT_FILE 3
+
+typedef struct
+{
+    EMITTER buf;
+    int language;
+    DIC_TYPE type;
+    char path[sizeof("XX/grunty_q/XXXX.grunty_q")];
+    size_t nameOffset;
+    int res[3]; // Results of OP_OPEN, OP_IO and OP_CLOSE
+} PENDING_FILE;
+
+typedef struct
+{
+    char fileName[6 + 4 + 1]; // filename + extension + '\0'
+    uint8_t blob[INPUT_MAX];
+    int res[3];
+    PENDING_FILE files[3];
+    unsigned int fileCount;
+} SLOT;
+
+typedef struct
+{
+    int inDir;
+    const char *path;
+    size_t pathLength;
+    char (*names)[6];
+    MANIFEST_JOB *jobs;
+    size_t count;
+    const CONFIG *config;
+    int (*outDirs)[DIC_TYPES];
+    unsigned int depth;
+} URING_RUN;
+
+typedef struct
+{
+    const URING_RUN *run;
+    struct io_uring ring;
+    bool ringReady;
+    SLOT *slots;
+    OUTPUT out;
+    STATS stats;
+    TRACE trace;
+} URING_WORKER;
+
+static inline uint64_t tag(unsigned int slot, unsigned int file, unsigned int op)
+{
+    return ((uint64_t)slot << 4) | (file << 2) | op;
+}
+
+/* Submits everything queued and waits for count completions, storing their results in the slots */
+static bool reap(URING_WORKER *w, unsigned int count)
+{
+    int r = io_uring_submit(&w->ring);
+    if(r < 0)
+    {
+        fprintf(stderr, "io_uring error: %s\n", strerror(-r));
+        return false;
+    }
+
+    while(count)
+    {
+        struct io_uring_cqe *cqe = NULL;
+        r = io_uring_wait_cqe(&w->ring, &cqe);
+        if(r == -EINTR)
+            continue;
+
+        if(r < 0)
+        {
+            fprintf(stderr, "io_uring error: %s\n", strerror(-r));
+            return false;
+        }
+
+        uint64_t t = io_uring_cqe_get_data64(cqe);
+        SLOT *slot = w->slots + (t >> 4);
+        unsigned int file = (t >> 2) & 0x03;
+        unsigned int op = t & 0x03;
+        if(file == INPUT_FILE)
+            slot->res[op] = cqe->res;
+        else
+            slot->files[file].res[op] = cqe->res;
+
+        io_uring_cqe_seen(&w->ring, cqe);
+        count--;
+    }
+
+    return true;
+}
+
+/* OUTPUT writer: Keeps the rendered file in the current slot until the write phase */
+static bool stashOutput(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset)
+{
+    SLOT *slot = out->ctx;
+    size_t pl = strlen(path) + 1;
+    if(slot->fileCount == 3 || pl > sizeof(slot->files[0].path))
+        return false;
+
+    // Swap the buffers, so the rendered data stays where it is
+    PENDING_FILE *file = slot->files + slot->fileCount++;
+    EMITTER tmp = file->buf;
+    file->buf = out->buf;
+    out->buf = tmp;
+
+    file->language = language;
+    file->type = type;
+    memcpy(file->path, path, pl);
+    file->nameOffset = nameOffset;
+    return true;
+}
+
+/* Worker job: Processes a batch of files */
+static int uringJob(void *ctx, size_t batch)
+{
+    URING_WORKER *w = ctx;
+    const URING_RUN *run = w->run;
+    size_t first = batch * run->depth;
+    unsigned int n = run->count - first < run->depth ? run->count - first : run->depth;
+    int ret = 0;
+
+    // Read all inputs
+    PHASE prev = statsEnter(w->out.stats, PHASE_READ);
+    size_t span = traceBegin(w->out.trace, "read", -1, NULL);
+    for(unsigned int i = 0; i < n; i++)
+    {
+        SLOT *slot = w->slots + i;
+        memcpy(slot->fileName, run->names[first + i], 6);
+        memcpy(slot->fileName + 6, ".bin", sizeof(".bin"));
+        slot->fileCount = 0;
+
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&w->ring);
+        io_uring_prep_openat_direct(sqe, run->inDir, slot->fileName, O_RDONLY, 0, i);
+        sqe->flags |= IOSQE_IO_LINK;
+        io_uring_sqe_set_data64(sqe, tag(i, INPUT_FILE, OP_OPEN));
+
+        // A short read is how we learn the filesize, so it must not break the chain
+        sqe = io_uring_get_sqe(&w->ring);
+        io_uring_prep_read(sqe, i, slot->blob, INPUT_MAX, 0);
+        sqe->flags |= IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+        io_uring_sqe_set_data64(sqe, tag(i, INPUT_FILE, OP_IO));
+
+        sqe = io_uring_get_sqe(&w->ring);
+        io_uring_prep_close_direct(sqe, i);
+        io_uring_sqe_set_data64(sqe, tag(i, INPUT_FILE, OP_CLOSE));
+    }
+
+    bool reaped = reap(w, n * 3);
+    traceEnd(w->out.trace, span);
+    if(!reaped)
+    {
+        statsEnter(w->out.stats, prev);
+        return 1;
+    }
+
+    // Parse them
+    statsEnter(w->out.stats, PHASE_PARSE);
+    char file[run->pathLength + sizeof(w->slots->fileName)];
+    memcpy(file, run->path, run->pathLength);
+    unsigned int parsed = 0;
+    for(; ret == 0 && parsed < n; parsed++)
+    {
+        SLOT *slot = w->slots + parsed;
+        memcpy(file + run->pathLength, slot->fileName, sizeof(slot->fileName));
+        char name[6 + 1];
+        memcpy(name, slot->fileName, 6);
+        name[6] = '\0';
+        PROBE1(process__entry, name);
+
+        if(slot->res[OP_OPEN] < 0)
+        {
+            fprintf(stderr, "%s not found\n", file);
+            ret = 1;
+        }
+        else if(slot->res[OP_IO] < 0)
+        {
+            fprintf(stderr, "I/O error: %s (%u)\n", strerror(-slot->res[OP_IO]), -slot->res[OP_IO]);
+            ret = 1;
+        }
+        else if(slot->res[OP_IO] <= 32 || slot->res[OP_IO] >= INPUT_MAX)
+        {
+            fprintf(stderr, "Sanity error (%s)\n", file);
+            ret = 1;
+        }
+        else
+        {
+            statsInput(w->out.stats, slot->blob, slot->res[OP_IO]);
+
+            // Unchanged content in incremental mode, nothing to do
+            if(run->jobs == NULL || manifestUpdate(run->jobs + first + parsed, slot->blob, slot->res[OP_IO]))
+            {
+                w->out.ctx = slot;
+                span = traceBegin(w->out.trace, "parse", -1, name);
+                ret = parseBlob(slot->blob, name, file, run->config, &w->out);
+                traceEnd(w->out.trace, span);
+            }
+        }
+
+        PROBE3(process__return, name, slot->res[OP_OPEN] < 0 ? -1 : slot->res[OP_IO], ret);
+    }
+
+    // Write the outputs of everything parsed
+    statsEnter(w->out.stats, PHASE_WRITE);
+    span = traceBegin(w->out.trace, "write", -1, NULL);
+    unsigned int queued = 0;
+    for(unsigned int i = 0; i < parsed; i++)
+    {
+        SLOT *slot = w->slots + i;
+        for(unsigned int j = 0; j < slot->fileCount; j++)
+        {
+            PENDING_FILE *pf = slot->files + j;
+            unsigned int index = run->depth + i * 3 + j;
+            PROBE2(output__open, pf->path, pf->language);
+
+            struct io_uring_sqe *sqe = io_uring_get_sqe(&w->ring);
+            io_uring_prep_openat_direct(sqe, run->outDirs[pf->language][pf->type], pf->path + pf->nameOffset,
+                                        O_WRONLY | O_CREAT | O_TRUNC, 0666, index);
+            sqe->flags |= IOSQE_IO_LINK;
+            io_uring_sqe_set_data64(sqe, tag(i, j, OP_OPEN));
+
+            // Hard link: Close even if the write fails or is short
+            sqe = io_uring_get_sqe(&w->ring);
+            io_uring_prep_write(sqe, index, pf->buf.data, pf->buf.size, 0);
+            sqe->flags |= IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+            io_uring_sqe_set_data64(sqe, tag(i, j, OP_IO));
+
+            sqe = io_uring_get_sqe(&w->ring);
+            io_uring_prep_close_direct(sqe, index);
+            io_uring_sqe_set_data64(sqe, tag(i, j, OP_CLOSE));
+            queued++;
+        }
+    }
+
+    reaped = reap(w, queued * 3);
+    traceEnd(w->out.trace, span);
+    statsEnter(w->out.stats, prev);
+    if(!reaped)
+        return 1;
+
+    for(unsigned int i = 0; i < parsed; i++)
+    {
+        SLOT *slot = w->slots + i;
+        for(unsigned int j = 0; j < slot->fileCount; j++)
+        {
+            PENDING_FILE *pf = slot->files + j;
+            PROBE3(output__close, pf->path, pf->buf.size, pf->res[OP_OPEN] >= 0 && pf->res[OP_IO] == (int)pf->buf.size && pf->res[OP_CLOSE] >= 0);
+            if(pf->res[OP_OPEN] < 0)
+            {
+                fprintf(stderr, "Error opening %s\n", pf->path);
+                ret = 1;
+            }
+            else if(pf->res[OP_IO] != (int)pf->buf.size || pf->res[OP_CLOSE] < 0)
+            {
+                fprintf(stderr, "Error writing %s\n", pf->path);
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+static bool workerInit(URING_WORKER *w, const URING_RUN *run, bool stats, bool trace)
+{
+    memset(w, 0, sizeof(URING_WORKER));
+    w->run = run;
+    emitterInit(&w->out.buf);
+    w->out.write = stashOutput;
+    statsInit(&w->stats);
+    w->out.stats = stats ? &w->stats : NULL;
+    traceInit(&w->trace);
+    w->out.trace = trace ? &w->trace : NULL;
+
+    w->slots = calloc(run->depth, sizeof(SLOT));
+    if(w->slots == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return false;
+    }
+
+    for(unsigned int i = 0; i < run->depth; i++)
+        for(int j = 0; j < 3; j++)
+            emitterInit(&w->slots[i].files[j].buf);
+
+    // Each file needs an open/io/close chain: One input + three outputs per slot, one batch at a time
+    unsigned int entries = 1;
+    while(entries < run->depth * 9)
+        entries <<= 1;
+
+    int r = io_uring_queue_init(entries, &w->ring, 0);
+    if(r < 0)
+    {
+        fprintf(stderr, "Error setting up io_uring: %s\n", strerror(-r));
+        return false;
+    }
+
+    w->ringReady = true;
+    r = io_uring_register_files_sparse(&w->ring, run->depth * 4);
+    if(r < 0)
+    {
+        fprintf(stderr, "Error registering io_uring files: %s\n", strerror(-r));
+        return false;
+    }
+
+    return true;
+}
+
+static void workerFree(URING_WORKER *w)
+{
+    if(w->ringReady)
+        io_uring_queue_exit(&w->ring);
+
+    if(w->slots != NULL)
+    {
+        for(unsigned int i = 0; i < w->run->depth; i++)
+            for(int j = 0; j < 3; j++)
+                emitterFree(&w->slots[i].files[j].buf);
+
+        free(w->slots);
+    }
+
+    emitterFree(&w->out.buf);
+    traceFree(&w->trace);
+}
+
+/*
+ * Converts the files using io_uring
+ *
+ * path is the input folder including the trailing '/' (not null terminated), only used for messages.
+ * The inputs get opened relative to inDir. jobs is NULL or has one entry for each name (see manifestUpdate()).
+ * The counters of the workers get added to stats and their timelines to trace, if not NULL.
+ * With io_uring a batch gets read and written at once, so the timelines have a read and a write span per batch.
+ */
+int uringRun(int inDir, const char *path, size_t pathLength, char (*names)[6], MANIFEST_JOB *jobs, size_t count, const CONFIG *config,
+             int outDirs[3][DIC_TYPES], unsigned int depth, unsigned int threads, STATS *stats,
+             TRACE_FILE *trace)
+{
+    URING_RUN run = {
+        .inDir = inDir,
+        .path = path,
+        .pathLength = pathLength,
+        .names = names,
+        .jobs = jobs,
+        .count = count,
+        .config = config,
+        .outDirs = outDirs,
+        .depth = depth,
+    };
+
+    URING_WORKER *workers = calloc(threads, sizeof(URING_WORKER));
+    if(workers == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    int ret = 0;
+    unsigned int ready = 0;
+    for(; ready < threads; ready++)
+    {
+        if(!workerInit(workers + ready, &run, stats != NULL, trace != NULL))
+        {
+            ret = 1;
+            ready++;
+            break;
+        }
+    }
+
+    if(ret == 0)
+        ret = poolRun((count + depth - 1) / depth, threads, uringJob, workers, sizeof(URING_WORKER));
+
+    for(unsigned int i = 0; i < ready; i++)
+    {
+        if(stats != NULL)
+            statsMerge(stats, &workers[i].stats);
+
+        if(trace != NULL)
+        {
+            char threadName[32];
+            snprintf(threadName, sizeof(threadName), "worker %u", i);
+            traceAppend(trace, &workers[i].trace, i + 1, threadName);
+        }
+
+        workerFree(workers + i);
+    }
+
+    free(workers);
+    return ret;
+}
+
+#endif
@@ -0,0 +1,15 @@
+#pragma once
+
+#ifdef HAVE_IO_URING
+
+#include "convert.h"
+#include "manifest.h"
+
+/* Maximum number of files in flight per worker */
+#define URING_MAX_DEPTH 1024
+
+int uringRun(int inDir, const char *path, size_t pathLength, char (*names)[6], MANIFEST_JOB *jobs, size_t count, const CONFIG *config,
+             int outDirs[3][DIC_TYPES], unsigned int depth, unsigned int threads, STATS *stats,
+             TRACE_FILE *trace);
+
+#endif
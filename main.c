@@ -1,42 +1,96 @@
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
-
-#include "dialogDic.h"
-#include "quizDic.h"
-
-typedef struct __attribute__((__packed__))
+#include <unistd.h>
+
+#include "archive.h"
+#include "convert.h"
+#include "dictionary.h"
+#include "encode.h"
+#include "inflate.h"
+#include "ioUring.h"
+#include "manifest.h"
+#include "probes.h"
+#include "ring.h"
+#include "stats.h"
+#include "trace.h"
+#include "workerPool.h"
+
+/* The .bin files found in the input folder and where to write to, shared by all workers */
+typedef struct
 {
-    uint16_t offsets[3];
-} LANGUAGE_FILE;
-
-typedef struct __attribute__((__packed__))
+    const char *path;
+    size_t pathLength;
+    char (*names)[6];
+    size_t count;
+    const CONFIG *config;
+    int outDirs[3][DIC_TYPES]; // Directory fds for XX/dialog, XX/quiz_q and XX/grunty_q
+    MANIFEST_JOB *jobs; // One for each name in incremental mode, NULL otherwise
+    bool writeIfChanged;
+    ARCHIVE *archive; // Everything goes in here instead of the output tree if not NULL
+    const uint8_t *image; // --image: The inputs are slices of this mapped file, the names are their offsets
+    size_t imageSize;
+    uint32_t *lengths; // --image: Upper bound of the size of each input from the sidecar index, NULL without one
+    bool inflate; // --inflate: The inputs are compressed, see inflate.h
+} FILE_LIST;
+
+/* Per worker state */
+typedef struct
+{
+    const FILE_LIST *list;
+    uint8_t blob[INPUT_MAX];
+    uint8_t packed[INPUT_MAX]; // --inflate: The compressed input, it gets unpacked into blob
+    OUTPUT out;
+    STRTAB_BUILDER strtab;
+    STATS stats;
+    TRACE trace;
+} WORKER;
+
+/* OUTPUT writer: Appends a rendered output file to the archive, under the same path as in the output tree */
+static bool archiveOutput(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset)
 {
-    uint8_t cmd;
-    uint8_t length;
-    char msg[];
-} MESSAGE;
+    (void)type;
+    (void)nameOffset;
+    const FILE_LIST *list = out->ctx;
+    PHASE prev = statsEnter(out->stats, PHASE_WRITE);
+    size_t span = traceBegin(out->trace, "write", language, path);
+    PROBE2(output__open, path, language);
+    bool ret = archiveAdd(list->archive, path, out->buf.data, out->buf.size);
+    PROBE3(output__close, path, out->buf.size, ret);
+    traceEnd(out->trace, span);
+    statsEnter(out->stats, prev);
+    return ret;
+}
 
-typedef struct __attribute__((__packed__))
+/* Adds the directories of the output tree to the archive */
+static bool archiveOutputDirs(ARCHIVE *archive)
 {
-    uint8_t count;
-    MESSAGE start[];
-} DIALOGUE;
+    for(int i = 0; i < 3; i++)
+    {
+        char path[sizeof("XX/grunty_q/")];
+        snprintf(path, sizeof(path), "%s/", lang[i]);
+        if(!archiveAddDir(archive, path))
+            return false;
 
-#define TO_RAW 0x00
-#define TO_ISO 0x01
-#define TO_UTF 0x02
-#define TO_CON 0x04
-#define TO_COM 0x08
+        for(int j = 0; j < DIC_TYPES; j++)
+        {
+            snprintf(path, sizeof(path), "%s/%s/", lang[i], typeDir[j]);
+            if(!archiveAddDir(archive, path))
+                return false;
+        }
+    }
 
-static const char *lang[] = {"EN", "FR", "DE"};
-// TODO: Make configurable:
-static unsigned int convert = TO_UTF | TO_CON | TO_COM;
+    return true;
+}
 
 /* Creates a directory recursively */
 static void mkdirRecursive(const char *path)
@@ -60,557 +114,1601 @@ static void mkdirRecursive(const char *path)
     }
 }
 
-/* Replaces characters from Rares character table with ISO-8859-1 */
-static void transformRareToIso(char *string)
+/*
+ * Creates the output directories and opens them
+ *
+ * This happens once at startup, so the parsers only need a single openat() per output file.
+ * Returns false on error, already opened directories will be left open.
+ */
+static bool openOutputDirs(int outDirs[3][DIC_TYPES])
 {
-    while(1)
+    for(int i = 0; i < 3; i++)
     {
-        switch((unsigned char)*string)
+        for(int j = 0; j < DIC_TYPES; j++)
         {
-            case 0x5B: // Ä
-                *string = 0xC4;
-                break;
-            case 0x5C: // Ö
-                *string = 0xD6;
-                break;
-            case 0x5D: // Ü
-            case 0x6A:
-                *string = 0xDC;
-                break;
-            case 0x5E: // ß
-                *string = 0xDF;
-                break;
-            case 0x5F: // À
-                *string = 0xC0;
-                break;
-            case 0x60: // Â
-                *string = 0xC2;
-                break;
-            case 0x61: // Ç
-                *string = 0xC7;
-                break;
-            case 0x62: // É
-                *string = 0xC9;
-                break;
-            case 0x63: // È
-                *string = 0xC8;
-                break;
-            case 0x64: // Ê
-                *string = 0xCA;
-                break;
-            case 0x65: // Ë
-                *string = 0xCB;
-                break;
-            case 0x66: // Î
-                *string = 0xCE;
-                break;
-            case 0x67: // Ï
-                *string = 0xCF;
-                break;
-            case 0x68: // Ô
-                *string = 0xD4;
-                break;
-            case 0x69: // Û
-                *string = 0xDB;
-                break;
-            case 0x6B: // Ù
-                *string = 0xD9;
-                break;
-            case 0xFC: // Control code like text shade, wobbly text, ...
-                string++; // Ignore next character
-            case '\0':
-                return;
-            default:
-                break;
-        }
+            char path[sizeof("XX/grunty_q")];
+            snprintf(path, sizeof(path), "%s/%s", lang[i], typeDir[j]);
+            mkdirRecursive(path);
 
-        string++;
+            outDirs[i][j] = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if(outDirs[i][j] == -1)
+            {
+                fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+                return false;
+            }
+        }
     }
+
+    return true;
 }
 
-/* Replaces characters from Rares character table with UTF-8 */
-static char *transformRareToUtf(char *string)
+static void closeOutputDirs(int outDirs[3][DIC_TYPES])
 {
-    size_t sl = strlen(string) + 1;
-    size_t j = 0;
-    static uint8_t stringBuffer[256];
-    for(size_t i = 0; i < sl; i++, j++)
+    for(int i = 0; i < 3; i++)
     {
-        if(j >= 254)
+        for(int j = 0; j < DIC_TYPES; j++)
         {
-            fprintf(stderr, "BUFFER OVERFLOW!\n");
-            stringBuffer[254] = '\0';
-            return (char *)stringBuffer;
+            if(outDirs[i][j] != -1)
+                close(outDirs[i][j]);
         }
+    }
+}
 
-        if((unsigned char)string[i] == 0xFD) // control code like text shade, wobbly text, ...
-        {
-            stringBuffer[j++] = string[i++];
-            stringBuffer[j] = string[i];
+/* Checks if the file name in dir already has the rendered content, comparing the size first */
+static bool sameContent(int dir, const char *name, const EMITTER *buf)
+{
+    int fd = openat(dir, name, O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+        return false;
+
+    struct stat st;
+    bool ret = fstat(fd, &st) == 0 && (size_t)st.st_size == buf->size;
+    char chunk[4096];
+    for(size_t done = 0; ret && done < buf->size; )
+    {
+        ssize_t r = read(fd, chunk, sizeof(chunk));
+        if(r == -1 && errno == EINTR)
             continue;
-        }
 
-        switch(string[i])
-        {
-            case 0x5B:
-                memcpy(stringBuffer + j++, "Ä", 2); // used sizeof("Ä") - 1 in the past but it's 2 for all chars anyway
-                break;
-            case 0x5C:
-                memcpy(stringBuffer + j++, "Ö", 2);
-                break;
-            case 0x5D:
-            case 0x6A:
-                memcpy(stringBuffer + j++, "Ü", 2);
-                break;
-            case 0x5E:
-                memcpy(stringBuffer + j++, "ß", 2);
-                break;
-            case 0x5F:
-                memcpy(stringBuffer + j++, "À", 2);
-                break;
-            case 0x60:
-                memcpy(stringBuffer + j++, "Â", 2);
-                break;
-            case 0x61:
-                memcpy(stringBuffer + j++, "Ç", 2);
-                break;
-            case 0x62:
-                memcpy(stringBuffer + j++, "É", 2);
-                break;
-            case 0x63:
-                memcpy(stringBuffer + j++, "È", 2);
-                break;
-            case 0x64:
-                memcpy(stringBuffer + j++, "Ê", 2);
-                break;
-            case 0x65:
-                memcpy(stringBuffer + j++, "Ë", 2);
-                break;
-            case 0x66:
-                memcpy(stringBuffer + j++, "Î", 2);
-                break;
-            case 0x67:
-                memcpy(stringBuffer + j++, "Ï", 2);
-                break;
-            case 0x68:
-                memcpy(stringBuffer + j++, "Ô", 2);
-                break;
-            case 0x69:
-                memcpy(stringBuffer + j++, "Û", 2);
-                break;
-            case 0x6B:
-                memcpy(stringBuffer + j++, "Ù", 2);
-                break;
-            case '\0':
-                stringBuffer[j] = '\0';
-                return (char *)stringBuffer;
-            default:
-                stringBuffer[j] = string[i];
-                break;
-        }
+        ret = r > 0 && (size_t)r <= buf->size - done && memcmp(chunk, buf->data + done, r) == 0;
+        done += r;
     }
 
-    return string;
+    close(fd);
+    return ret;
 }
 
 /*
- * Maps a .bin filename to the corresponding .dialog filename
+ * Write-if-changed mode: Replaces the file name in dir with the rendered content
  *
- * Expects a 6 char string as input
- * (null terminator not counted nor needed as it compares 6 bytes only)
+ * The content goes to a temporary file which then gets renamed over the old one,
+ * so anyone watching the file sees either the old or the new version.
  */
-static const char *mapDialog(const char *in)
+static bool replaceOutput(int dir, const char *path, const char *name, const EMITTER *buf)
 {
-    for(size_t i = 0; i < DIAG_LIST_MAX; i++)
-        if(memcmp(in, diagInList[i], 6) == 0)
-            return diagOutList[i];
+    char tmp[sizeof(".XXXX.grunty_q.tmp")];
+    if((size_t)snprintf(tmp, sizeof(tmp), ".%s.tmp", name) >= sizeof(tmp))
+        return false;
 
-    return NULL;
-}
+    int fd = openat(dir, tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if(fd == -1)
+    {
+        fprintf(stderr, "Error opening %s\n", path);
+        return false;
+    }
 
-static const char *mapQuiz(const char *in)
-{
-    for(size_t i = 0; i < QUIZ_LIST_MAX; i++)
-        if(memcmp(in, quizInList[i], 6) == 0)
-            return quizOutList[i];
+    bool ret = emitterFlush(buf, fd);
+    if(close(fd) == -1)
+        ret = false;
 
-    return NULL;
-}
+    if(ret && renameat(dir, tmp, dir, name) == -1)
+        ret = false;
 
-static const char *mapGrunty(const char *in)
-{
-    for(size_t i = 0; i < GRUNTY_LIST_MAX; i++)
-        if(memcmp(in, gruntyInList[i], 6) == 0)
-            return gruntyOutList[i];
+    if(!ret)
+    {
+        fprintf(stderr, "Error writing %s\n", path);
+        unlinkat(dir, tmp, 0);
+    }
 
-    return NULL;
+    return ret;
 }
 
 /*
- * Parse a .bin file representing a .quiz_q file
+ * OUTPUT writer: Writes a rendered output file synchronously
  *
- * This will map the .bin file to the corresponding .quiz_q file and create said .quiz_q file with YAML content.
- * It will write to stderr and skip the .bin file in case of no map entry (no .dialog file to write to known)
+ * path is the full path for error messages, the file gets created relative to the language/type directory
+ * with the filename starting at path + nameOffset
  */
-static int parseQuiz(uint8_t *blob, const char *name, bool grunty)
+static bool writeOutput(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset)
 {
-    const char *outName = grunty ? mapGrunty(name) : mapQuiz(name);
-    if(outName == NULL)
-    {
-        fprintf(stderr, "No map entry for quiz_q %s.bin\n", name);
-        return 0;
-    }
-
-    // The path buffer for the files to write to. The Xes will be replaced later
-    char outPath[grunty ? sizeof("XX/grunty_q/XXXX.grunty_q") : sizeof("XX/quiz_q/XXXX.quiz_q")];
-    size_t pl;
-    if(grunty)
-    {
-        memcpy(outPath, "XX/grunty_q/XXXX.grunty_q", sizeof("XX/grunty_q/XXXX.grunty_q"));
-        pl = sizeof("XX/grunty_q/") - 1;
-    }
+    const FILE_LIST *list = out->ctx;
+    int dir = list->outDirs[language][type];
+    PHASE prev = statsEnter(out->stats, PHASE_WRITE);
+    size_t span = traceBegin(out->trace, "write", language, path);
+    PROBE2(output__open, path, language);
+    bool ret;
+    if(list->writeIfChanged)
+        ret = sameContent(dir, path + nameOffset, &out->buf) || replaceOutput(dir, path, path + nameOffset, &out->buf);
     else
     {
-        memcpy(outPath, "XX/quiz_q/XXXX.quiz_q", sizeof("XX/quiz_q/XXXX.quiz_q"));
-        pl = sizeof("XX/quiz_q/") - 1;
-    }
+        int fd = openat(dir, path + nameOffset, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        ret = fd != -1 && emitterFlush(&out->buf, fd);
+        if(fd != -1 && close(fd) == -1)
+            ret = false;
 
-    // Replace XXXX with the file name
-    memcpy(outPath + pl--, outName, 4);
+        if(!ret)
+            fprintf(stderr, fd == -1 ? "Error opening %s\n" : "Error writing %s\n", path);
+    }
 
-    // Cast the blob into a LANGUAGE_FILE struct
-    LANGUAGE_FILE *lf = (LANGUAGE_FILE *)(blob + 0x03);
+    PROBE3(output__close, path, out->buf.size, ret);
+    traceEnd(out->trace, span);
+    statsEnter(out->stats, prev);
+    return ret;
+}
 
-    // Loop over the DIALOGUE structs to get count of and the pointers for the MESSAGE structs in the blob
-    for(int i = 0; i < 3; i++)
+/* Converts an input once it's in memory, filesize is what got read (a full buffer means the file is too big) */
+static int convertBlob(const char *name, const char *file, const CONFIG *config, const uint8_t *blob, ssize_t filesize, OUTPUT *out, MANIFEST_JOB *job)
+{
+    if(filesize <= 32 || filesize >= INPUT_MAX)
     {
-        // Replace the XX in out path buffer with the language (EN/FR/DE)
-        memcpy(outPath, lang[i], 2);
+        fprintf(stderr, "Sanity error (%s)\n", file);
+        return 1;
+    }
 
-        outPath[pl] = '\0';
-        mkdirRecursive(outPath);
-        outPath[pl] = '/';
+    statsInput(out->stats, blob, filesize);
+    PHASE prev = statsEnter(out->stats, PHASE_PARSE);
+    size_t span = traceBegin(out->trace, "parse", -1, NULL);
+    int ret = job != NULL && !manifestUpdate(job, blob, filesize) ? 0 : parseBlob(blob, name, file, config, out);
+    traceEnd(out->trace, span);
+    statsEnter(out->stats, prev);
+    return ret;
+}
 
-        FILE *f = fopen(outPath, "wb");
-        if(f == NULL)
-        {
-            fprintf(stderr, "Error opening %s\n", outPath);
-            return 1;
-        }
+/*
+ * --inflate: Unpacks a compressed input into blob, returns the unpacked size or -1
+ *
+ * Inputs with a Rare-zip header get checked against the size in it, everything else has to be raw deflate data.
+ * Nothing gets unpacked that wouldn't fit into blob as an uncompressed input.
+ */
+static ssize_t unpackInput(const char *file, const uint8_t *packed, size_t size, uint8_t *blob, OUTPUT *out)
+{
+    PHASE prev = statsEnter(out->stats, PHASE_INFLATE);
+    size_t span = traceBegin(out->trace, "inflate", -1, NULL);
+    ssize_t ret = isRareZip(packed, size) ? inflateRareZip(packed, size, blob, INPUT_MAX - 1) : inflateBlock(packed, size, blob, INPUT_MAX - 1);
+    traceEnd(out->trace, span);
+    statsEnter(out->stats, prev);
+    if(ret == -1)
+        fprintf(stderr, "Inflate error (%s)\n", file);
 
-        fprintf(f, "type: QuizQuestion\n"
-                   "question:\n");
+    return ret;
+}
 
-        // Point and cast to the DIALOGUE structs found in the blob
-        // Each DIALOGUE struct corresponds to one language (EN/FR/DE)
-        DIALOGUE *diag = (DIALOGUE *)(blob + lf->offsets[i]);
+/*
+ * Reads a whole input file into buf with a single read(), returns the filesize or -1
+ *
+ * As files have to be smaller than INPUT_MAX a short read tells the filesize, so no fstat()/lseek() needed.
+ */
+static ssize_t readInput(const char *file, uint8_t *buf, OUTPUT *out)
+{
+    ssize_t filesize = -1;
+    size_t span = traceBegin(out->trace, "read", -1, NULL);
+    PHASE prev = statsEnter(out->stats, PHASE_READ);
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if(fd != -1)
+    {
+        // Read the whole file, a full buffer means the file is too big. Retried if a signal came in before any data
+        do
+            filesize = read(fd, buf, INPUT_MAX);
+        while(filesize == -1 && errno == EINTR);
 
-        MESSAGE *msg = diag->start;
-        bool firstAnswer = true;
+        if(filesize == -1)
+            fprintf(stderr, "I/O error: %s (%u)\n", strerror(errno), errno);
 
-        // Loop over the MESSAGE structs found
-        // Parse them and write out as YAML
-        for(uint8_t j = 0; j < diag->count; j++)
-        {
-            if(firstAnswer && msg->cmd & ~(0x80))
-            {
-                fprintf(f, "options:\n");
-                firstAnswer = false;
-            }
+        close(fd);
+    }
+    else
+        fprintf(stderr, "%s not found\n", file);
 
-            fprintf(f, "  - { cmd: 0x%02X, string: \"", msg->cmd);
+    statsEnter(out->stats, prev);
+    traceEnd(out->trace, span);
+    return filesize;
+}
 
-            if(!firstAnswer && (convert & TO_CON))
-            {
-                if(convert & TO_COM)
-                    fprintf(f, "%c%c", 0xFD, 'l');
-                else
-                    fprintf(f, "\\xFDl");
-            }
+/*
+ * Converts a read input, unpacking it from packed into blob first with --inflate (packed != NULL)
+ *
+ * In incremental mode job gets updated and files with unchanged content don't get parsed.
+ */
+static int convertInput(const char *name, const char *file, const CONFIG *config, uint8_t *blob, const uint8_t *packed, ssize_t filesize, OUTPUT *out, MANIFEST_JOB *job)
+{
+    if(filesize == -1)
+        return 1;
 
-            char *m = msg->msg;
-            if(convert & TO_ISO)
-                transformRareToIso(m);
-            else if(convert & TO_UTF)
-                m = transformRareToUtf(m);
+    if(packed != NULL && filesize < INPUT_MAX && (filesize = unpackInput(file, packed, filesize, blob, out)) == -1)
+        return 1;
 
-            fprintf(f, "%s\" }\n", m);
-            msg = (MESSAGE *)(((uint8_t *)msg) + 2 + msg->length);
-        }
+    return convertBlob(name, file, config, blob, filesize, out, job);
+}
+
+/* This processes a .bin file: Reads it into the workers buffer (packed with --inflate) and converts it */
+static int process(const char *name, const char *file, const CONFIG *config, uint8_t *blob, uint8_t *packed, OUTPUT *out, MANIFEST_JOB *job)
+{
+    PROBE1(process__entry, name);
+    size_t span = traceBegin(out->trace, "file", -1, name);
+    ssize_t filesize = readInput(file, packed != NULL ? packed : blob, out);
+    int ret = convertInput(name, file, config, blob, packed, filesize, out, job);
+    traceEnd(out->trace, span);
+    PROBE3(process__return, name, filesize, ret);
+    return ret;
+}
 
-        fclose(f);
+/*
+ * Converts the n-th asset of --image straight from the mapped image, without copying it
+ *
+ * Its size comes from walking its structure (see blobSize()), which never goes beyond the image nor beyond the
+ * size in the sidecar index. With --inflate the asset is compressed and gets unpacked into blob instead.
+ */
+static int processAsset(const char *name, const FILE_LIST *list, size_t n, uint8_t *blob, OUTPUT *out)
+{
+    uint32_t offset = dicKey(name);
+    size_t max = offset < list->imageSize ? list->imageSize - offset : 0;
+    if(list->lengths != NULL && list->lengths[n] < max)
+        max = list->lengths[n];
+
+    PROBE1(process__entry, name);
+    size_t span = traceBegin(out->trace, "file", -1, name);
+    ssize_t size;
+    int ret = 1;
+    if(list->inflate)
+    {
+        size = unpackInput(name, list->image + offset, max, blob, out);
+        if(size != -1)
+            ret = convertBlob(name, name, list->config, blob, size, out, NULL);
     }
+    else if((size = blobSize(list->image + offset, max)) == 0)
+        fprintf(stderr, "No .bin file at offset 0x%s of the image\n", name);
+    else
+        ret = convertBlob(name, name, list->config, list->image + offset, size, out, NULL);
 
-    return 0;
+    traceEnd(out->trace, span);
+    PROBE3(process__return, name, size, ret);
+    return ret;
+}
+
+/* Builds the path of the n-th input file and its name, file has to hold INPUT_PATH_SIZE(list) bytes */
+#define INPUT_PATH_SIZE(list) ((list)->pathLength + (6 + 1 + 3 + 1)) // path + filename + '.' + extension + '\0'
+static void inputPath(const FILE_LIST *list, size_t n, char *file, char name[6 + 1])
+{
+    memcpy(file, list->path, list->pathLength);
+    memcpy(file + list->pathLength, list->names[n], 6);
+    memcpy(file + list->pathLength + 6, ".bin", sizeof(".bin"));
+    memcpy(name, list->names[n], 6);
+    name[6] = '\0';
 }
 
 /*
- * Parse a .bin file representing a .dialog file
+ * Worker job: Processes the n-th file of the list
  *
- * This will map the .bin file to the corresponding .dialog file and create said .dialog file with YAML content.
- * It will write to stderr and skip the .bin file in case of no map entry (no .dialog file to write to known)
+ * Each worker builds the path to the file in its own buffer, so this is safe to run from multiple threads
  */
-static int parseDialog(uint8_t *blob, const char *name)
+static int processJob(void *ctx, size_t n)
 {
-    const char *outName = mapDialog(name);
-    if(outName == NULL)
+    WORKER *worker = ctx;
+    const FILE_LIST *list = worker->list;
+    strtabSetInput(worker->out.strtab, n);
+    if(list->image != NULL)
     {
-        fprintf(stderr, "No map entry for dialog %s.bin\n", name);
-        return 0;
+        char name[6 + 1];
+        memcpy(name, list->names[n], 6);
+        name[6] = '\0';
+        return processAsset(name, list, n, worker->blob, &worker->out);
     }
 
-    char outPath[] = "XX/dialog/XXXX.dialog";
-    memcpy(outPath + sizeof("XX/dialog/") - 1, outName, 4);
+    char file[INPUT_PATH_SIZE(list)];
+    char name[6 + 1];
+    inputPath(list, n, file, name);
+    return process(name, file, list->config, worker->blob, list->inflate ? worker->packed : NULL, &worker->out, list->jobs ? list->jobs + n : NULL);
+}
 
-    LANGUAGE_FILE *lf = (LANGUAGE_FILE *)(blob + 0x01);
-    for(int i = 0; i < 3; i++)
-    {
-        memcpy(outPath, lang[i], 2);
-//        printf("--> %s\n", outPath);
+/*
+ * --pipeline: The inputs read ahead and the rendered files in flight at most, this caps the memory use
+ *
+ * There are PIPELINE_DEPTH input slots of INPUT_MAX bytes. Rendered files get queued up to PIPELINE_DEPTH as well.
+ */
+#define PIPELINE_DEPTH 64
+#define PIPELINE_MAX_THREADS 256
 
-        outPath[sizeof("XX/dialog") - 1] = '\0';
-        mkdirRecursive(outPath);
-        outPath[sizeof("XX/dialog") - 1] = '/';
+/* An input read by a reader, it goes back to the free slots once parsed */
+typedef struct
+{
+    size_t n; // Index into FILE_LIST.names
+    ssize_t size; // What readInput() returned
+    uint8_t data[INPUT_MAX];
+    char file[]; // INPUT_PATH_SIZE()
+} INPUT_SLOT;
+
+/* A rendered file on its way to a writer. Its buffer gets swapped with the one of the parser, no copies */
+typedef struct
+{
+    EMITTER buf;
+    int language;
+    DIC_TYPE type;
+    size_t nameOffset;
+    char path[sizeof("XX/grunty_q/XXXX.grunty_q")];
+} OUTPUT_FILE;
+
+/* The queues between the stages, shared by all pipeline threads */
+typedef struct
+{
+    const FILE_LIST *list;
+    atomic_size_t next; // The next input to read
+    atomic_int ret;
+    RING free; // Empty input slots, the readers wait here when the parsers fall behind
+    RING filled; // Read inputs for the parsers
+    RING rendered; // Output files for the writers
+    RING spare; // Written output files, so their buffers get reused
+    bool (*write)(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset);
+} PIPELINE;
+
+/* A reader or writer thread, the parsers are WORKERs */
+typedef struct
+{
+    PIPELINE *pipeline;
+    OUTPUT out;
+    STATS stats;
+    TRACE trace;
+} STAGE_THREAD;
 
-        // Open the .dialog file for writing and write YAML to it
-        FILE *f = fopen(outPath, "wb");
-        if(f == NULL)
-        {
-            fprintf(stderr, "Error opening %s\n", outPath);
-            return 1;
-        }
+static void pipelineFail(PIPELINE *p, int ret)
+{
+    int expected = 0;
+    atomic_compare_exchange_strong(&p->ret, &expected, ret);
+}
 
-        // Loop over bottom messages
-        fprintf(f, "type: Dialog\n"
-                   "bottom:\n");
-        DIALOGUE *diag = (DIALOGUE *)(blob + lf->offsets[i]);
-        MESSAGE *msg = diag->start;
-        uint8_t count = diag->count;
-        bool special = false;
-        for(uint8_t j = 0; j < count; j++)
+/* Reader stage: Takes the next input from the list and reads it into a free slot */
+static void *readerMain(void *arg)
+{
+    STAGE_THREAD *t = arg;
+    PIPELINE *p = t->pipeline;
+    INPUT_SLOT *slot;
+    while(atomic_load_explicit(&p->ret, memory_order_relaxed) == 0 && ringPop(&p->free, (void **)&slot))
+    {
+        size_t n = atomic_fetch_add_explicit(&p->next, 1, memory_order_relaxed);
+        if(n >= p->list->count)
         {
-            char *m = msg->msg;
-            if((msg->cmd & 0x80) || (special && (msg->cmd & 0x08)))
-            {
-                if(convert & TO_ISO)
-                    transformRareToIso(m);
-                else if(convert & TO_UTF)
-                    m = transformRareToUtf(m);
+            ringPush(&p->free, slot);
+            break;
+        }
 
-                if(!special)
-                    special = msg->cmd & 0x40 || msg->cmd == 0xBC; // is 0xBC a game bug? Cause others are 0xCB, 0xD0, 0xD1
-            }
+        char name[6 + 1];
+        inputPath(p->list, n, slot->file, name);
+        slot->n = n;
+        slot->size = readInput(slot->file, slot->data, &t->out);
+        ringPush(&p->filled, slot);
+    }
 
-            fprintf(f, "  - { cmd: 0x%02X, string: \"%s\" }\n", msg->cmd, m);
-            msg = (MESSAGE *)(((uint8_t *)msg) + 2 + msg->length);
-        }
+    ringDone(&p->filled);
+    return NULL;
+}
 
-        // Loop over top messages
-        fprintf(f, "top:\n");
-        count = *(uint8_t *)msg;
-        msg = (MESSAGE *)(((uint8_t *)msg) + 0x01);
-        for(uint8_t j = 0; j < count; j++)
+/* OUTPUT writer of the parsers: Hands the rendered file over to the writers and continues with a spare buffer */
+static bool queueOutput(OUTPUT *out, int language, DIC_TYPE type, const char *path, size_t nameOffset)
+{
+    PIPELINE *p = out->ctx;
+    OUTPUT_FILE *file;
+    if(!ringTryPop(&p->spare, (void **)&file))
+    {
+        file = malloc(sizeof(OUTPUT_FILE));
+        if(file == NULL)
         {
-            char *m = msg->msg;
-            if(msg->cmd & 0x80)
-            {
-                if(convert & TO_ISO)
-                    transformRareToIso(m);
-                else if(convert & TO_UTF)
-                    m = transformRareToUtf(m);
-            }
-
-            fprintf(f, "  - { cmd: 0x%02X, string: \"%s\" }\n", msg->cmd, m);
-            msg = (MESSAGE *)(((uint8_t *)msg) + 2 + msg->length);
+            fprintf(stderr, "Out of memory\n");
+            return false;
         }
 
-        // Close output file
-        fclose(f);
+        emitterInit(&file->buf);
     }
 
-    return 0;
+    EMITTER buf = file->buf;
+    file->buf = out->buf;
+    out->buf = buf;
+    file->language = language;
+    file->type = type;
+    file->nameOffset = nameOffset;
+    snprintf(file->path, sizeof(file->path), "%s", path);
+
+    // Waiting for the writers is no parsing
+    PHASE prev = statsEnter(out->stats, PHASE_OTHER);
+    ringPush(&p->rendered, file);
+    statsEnter(out->stats, prev);
+    return true;
 }
 
-/*
- * This processes a .bin file
- *
- * So it prses its file magic (first two bytes) to decide if dialog or quiz_q,
- * reads the file into a buffer and handles that blob to the corresponding parser function
- */
-static int process(const char *name, const char *file)
+/* Parser stage: Converts the read inputs, the slots go back to the readers */
+static void *parserMain(void *arg)
 {
-    int ret = 1;
-
-    // Open file
-    FILE *f = fopen(file, "rb");
-    if(f)
+    WORKER *w = arg;
+    PIPELINE *p = w->out.ctx;
+    const FILE_LIST *list = w->list;
+    INPUT_SLOT *slot;
+    while(ringPop(&p->filled, (void **)&slot))
     {
-        // Get filesize from open file
-        if(fseek(f, 0L, SEEK_END) == 0)
+        // After an error only drain the queue, so the readers don't wait for free slots forever
+        if(atomic_load_explicit(&p->ret, memory_order_relaxed) == 0)
         {
-            size_t filesize = ftell(f);
-            if(filesize > 32 && filesize < 4096)
-            {
-                // Create buffer and read file into it
-                if(fseek(f, 0L, SEEK_SET) == 0)
-                {
-                    uint8_t blob[filesize];
-                    if(fread(blob, filesize, 1, f) == 1)
-                    {
-                        uint16_t magic = *(uint16_t *)blob;
-                        bool grunty = false;
-                        switch(magic)
-                        {
-                            case 0x0703: // .dialog
-                                ret = parseDialog(blob, name);
-                                break;
-                            case 0x0303: // .grunty_q
-                                grunty = true;
-                            case 0x0103: // .quiz_q
-                                ret = parseQuiz(blob, name, grunty);
-                                break;
-                            default:
-                                fprintf(stderr, "Unknown file magic for %s: 0x%04X\n", file, magic);
-                        }
-                    }
-                    else
-                        fprintf(stderr, "Error reading %s\n", file);
-                }
-                else
-                    fprintf(stderr, "I/O error: %s (%u)\n", strerror(errno), errno);
-            }
-            else
-                fprintf(stderr, "Sanity error (%s)\n", file);
+            char name[6 + 1];
+            memcpy(name, list->names[slot->n], 6);
+            name[6] = '\0';
+            PROBE1(process__entry, name);
+            size_t span = traceBegin(w->out.trace, "file", -1, name);
+            strtabSetInput(w->out.strtab, slot->n);
+            int ret = convertInput(name, slot->file, list->config, list->inflate ? w->blob : slot->data, list->inflate ? slot->data : NULL,
+                                   slot->size, &w->out, list->jobs ? list->jobs + slot->n : NULL);
+            traceEnd(w->out.trace, span);
+            PROBE3(process__return, name, slot->size, ret);
+            if(ret != 0)
+                pipelineFail(p, ret);
         }
-        else
-            fprintf(stderr, "I/O error: %s (%u)\n", strerror(errno), errno);
 
-        // Close input file
-        fclose(f);
+        ringPush(&p->free, slot);
     }
-    else
-        fprintf(stderr, "%s not found\n", file);
 
-    return ret;
+    ringDone(&p->free);
+    ringDone(&p->rendered);
+    return NULL;
 }
 
-static void showHelp(char *prog)
+/* Writer stage: Writes the rendered files with the writer of the list (output tree or archive) */
+static void *writerMain(void *arg)
 {
-    fprintf(stderr, "Usage: %s [-u|-i|-r]  [-w|-c|-n] input/path\n"
-                    "\t-u: Convert strings to UTF-8 (default)\n"
-                    "\t-i: Convert strings to ISO-8859-1\n"
-                    "\t-r: Dump strings raw (RARE character table)\n"
-                    "\t-w: Add control bytes (\"\\xFDl\") to beginning of answers (needed by Banjo: Recompiled but missing in PAL ROM)\n"
-                    "\t-c: Add compressed control bytes (same as above but instead of writing as escape codes write them binary) (default)\n"
-                    "\t-n: Don't add control bytes (see above)\n", prog);
+    STAGE_THREAD *t = arg;
+    PIPELINE *p = t->pipeline;
+    OUTPUT_FILE *file;
+    while(ringPop(&p->rendered, (void **)&file))
+    {
+        t->out.buf = file->buf;
+        if(!p->write(&t->out, file->language, file->type, file->path, file->nameOffset))
+            pipelineFail(p, 1);
+
+        emitterReset(&file->buf);
+        if(!ringTryPush(&p->spare, file))
+        {
+            emitterFree(&file->buf);
+            free(file);
+        }
+    }
+
+    return NULL;
 }
 
 /*
- * Entry function of the program
+ * --pipeline: Runs the list through separate reader, parser and writer threads
  *
- * It accepts exactly one argument: A path containing .bin files
+ * The stages are connected by bounded lock-free queues, so readers prefetch while the parsers work and the parsers
+ * go on while the writers wait for the disk. A stage which gets ahead waits for room in the queue to the next one.
+ * parsers are initialized WORKERs, their string tables and stats stay with them. stats and trace are NULL when
+ * not wanted, the stage counts and waits get booked to stats.
  */
-int main(int argc, char *argv[])
+static int pipelineRun(const FILE_LIST *list, WORKER *parsers, const unsigned int stages[STAGES], STATS *stats, TRACE_FILE *trace)
 {
-    // Check if argument is there
-    if(argc < 2)
+    PIPELINE p = {
+        .list = list,
+        .write = list->archive ? archiveOutput : writeOutput,
+    };
+
+    atomic_init(&p.next, 0);
+    atomic_init(&p.ret, 0);
+    unsigned int readers = stages[STAGE_READ];
+    unsigned int writers = stages[STAGE_WRITE];
+    unsigned int threads = readers + stages[STAGE_PARSE] + writers;
+    STAGE_THREAD *others = malloc(sizeof(STAGE_THREAD) * (readers + writers));
+    pthread_t *ids = malloc(sizeof(pthread_t) * threads);
+    size_t slotSize = sizeof(INPUT_SLOT) + INPUT_PATH_SIZE(list);
+    uint8_t *slots = malloc(slotSize * PIPELINE_DEPTH);
+    bool rings = ringInit(&p.free, PIPELINE_DEPTH, stages[STAGE_PARSE]);
+    rings = ringInit(&p.filled, PIPELINE_DEPTH, readers) && rings;
+    rings = ringInit(&p.rendered, PIPELINE_DEPTH, stages[STAGE_PARSE]) && rings;
+    rings = ringInit(&p.spare, PIPELINE_DEPTH, 0) && rings;
+    int ret = 0;
+    if(others == NULL || ids == NULL || slots == NULL || !rings)
     {
-        showHelp(argv[0]);
-        return 1;
+        fprintf(stderr, "Out of memory\n");
+        ret = 1;
     }
 
-    const char *path = argv[--argc];
-    if(argc > 1)
+    for(size_t i = 0; ret == 0 && i < PIPELINE_DEPTH; i++)
+        ringTryPush(&p.free, slots + slotSize * i);
+
+    // Writers first and readers last, so if a thread can't be started nothing got read yet and everything winds down
+    unsigned int started = 0;
+    for(unsigned int i = 0; ret == 0 && i < threads; i++)
     {
-        for(int i = 1; i < argc; i++)
+        void *(*fn)(void *);
+        void *arg;
+        if(i < writers || i >= threads - readers)
         {
-            if(argv[i][0] != '-')
-            {
-                showHelp(argv[0]);
-                return 1;
-            }
+            STAGE_THREAD *t = others + (i < writers ? i : i - stages[STAGE_PARSE]);
+            t->pipeline = &p;
+            emitterInit(&t->out.buf);
+            t->out.write = NULL;
+            t->out.ctx = (void *)list;
+            t->out.strtab = NULL;
+            statsInit(&t->stats);
+            t->out.stats = stats ? &t->stats : NULL;
+            traceInit(&t->trace);
+            t->out.trace = trace ? &t->trace : NULL;
+            fn = i < writers ? writerMain : readerMain;
+            arg = t;
+        }
+        else
+        {
+            parsers[i - writers].out.write = queueOutput;
+            parsers[i - writers].out.ctx = &p;
+            fn = parserMain;
+            arg = parsers + i - writers;
+        }
 
-            switch(argv[i][1])
-            {
-                case 'i':
-                    convert &= ~(TO_UTF);
-                    convert |= TO_ISO;
-                    break;
-                case 'u':
-                    convert &= ~(TO_ISO);
-                    convert |= TO_UTF;
-                    break;
-                case 'r':
-                    convert &= ~(TO_UTF | TO_ISO);
-                    break;
-                case 'w':
-                    convert &= ~(TO_COM);
-                    convert |= TO_CON;
-                    break;
-                case 'c':
-                    convert |= TO_CON | TO_COM;
-                    break;
-                case 'n':
-                    convert &= ~(TO_CON | TO_COM);
-                    break;
-                default:
-                    showHelp(argv[0]);
-                    return 1;
-            }
+        if(pthread_create(ids + i, NULL, fn, arg) != 0)
+        {
+            fprintf(stderr, "Error creating pipeline thread\n");
+            ret = 1;
+            break;
+        }
+
+        started++;
+    }
 
-            if(argv[i][2] != '\0')
+    // Stand in for the stages that didn't start, so the queues still get closed
+    if(ret != 0)
+    {
+        for(unsigned int i = started; i < threads; i++)
+        {
+            if(i >= threads - readers)
+                ringDone(&p.filled);
+            else if(i >= writers)
             {
-                showHelp(argv[0]);
-                return 1;
+                ringDone(&p.free);
+                ringDone(&p.rendered);
             }
         }
     }
 
-    if(convert & TO_UTF)
-        printf("Converting strings to UTF-8");
-    else if(convert & TO_ISO)
-        printf("Converting strings to ISO-8859-1");
-    else
-        printf("Dumping strings raw (RARE character table)");
-
-    if(convert & TO_CON)
-        printf(" (adding control bytes to answers)");
+    for(unsigned int i = 0; i < started; i++)
+        pthread_join(ids[i], NULL);
 
-    printf("\n");
+    if(ret == 0)
+        ret = atomic_load(&p.ret);
 
-    // Open directory
-    DIR *folder = opendir(path);
-    if(!folder)
+    // The parsers are merged by the caller, which also wants their trace
+    for(unsigned int i = 0; others != NULL && i < threads; i++)
     {
-        fprintf(stderr, "Error opening %s\n", path);
-        return 1;
-    }
-
-    // Loop over all files in the folder, create a new path array containing the folder + the filename and process the files
-    size_t sl = strlen(path);
-    char newPath[sl + (1 + 6 + 1 + 3 + 1)]; // path + '/' + filename + '.' + extension + '\0'
-    memcpy(newPath, path, sl);
-    newPath[sl++] = '/';
-    newPath[sl + (6 + 1 + 3)] = '\0'; // Add null terminator to end of buffer as memcpy will not copy it later
-    struct dirent *entry;
-    int ret = 0;
-    while (ret == 0 && (entry = readdir(folder)) != NULL) {
-        // Check if file is not hidden, is a real file, filename is 10 chars long (including extension) and extension is .bin. Skip otherwise
-        if(entry->d_name[0] == '.' || entry->d_type != DT_REG || strlen(entry->d_name) != 6 + 1 + 3 /* filename + '.' + extension */ || memcmp(entry->d_name + 6, ".bin", 4) != 0)
+        if(i >= writers && i < threads - readers)
             continue;
 
-        // Copy filename to end of new path
-        memcpy(newPath + sl, entry->d_name, 6 + 1 + 3); // filename + '.' + extension
+        STAGE_THREAD *t = others + (i < writers ? i : i - stages[STAGE_PARSE]);
+        if(i < started)
+        {
+            if(stats != NULL)
+                statsMerge(stats, &t->stats);
+
+            if(trace != NULL)
+            {
+                char threadName[32];
+                if(i < writers)
+                    snprintf(threadName, sizeof(threadName), "writer %u", i);
+                else
+                    snprintf(threadName, sizeof(threadName), "reader %u", i - (threads - readers));
+
+                traceAppend(trace, &t->trace, 1 + stages[STAGE_PARSE] + (i < writers ? readers + i : i - (threads - readers)), threadName);
+            }
 
-        // Cut extension from filename
-        entry->d_name[6] = '\0';
-        ret = process(entry->d_name, newPath);
+            traceFree(&t->trace);
+        }
     }
 
-    // Close the folder and exit the program
-    closedir(folder);
-    if(ret == 0)
-        printf("Done\n");
+    if(stats != NULL)
+    {
+        for(int i = 0; i < STAGES; i++)
+            stats->stages[i] = stages[i];
 
-    return ret;
+        stats->blocked[STAGE_READ] = atomic_load(&p.free.popWaits);
+        stats->starved[STAGE_PARSE] = atomic_load(&p.filled.popWaits);
+        stats->blocked[STAGE_PARSE] = atomic_load(&p.rendered.pushWaits);
+        stats->starved[STAGE_WRITE] = atomic_load(&p.rendered.popWaits);
+    }
+
+    OUTPUT_FILE *file;
+    while(rings && ringTryPop(&p.spare, (void **)&file))
+    {
+        emitterFree(&file->buf);
+        free(file);
+    }
+
+    ringFree(&p.free);
+    ringFree(&p.filled);
+    ringFree(&p.rendered);
+    ringFree(&p.spare);
+    free(slots);
+    free(ids);
+    free(others);
+    return ret;
+}
+
+/*
+ * Stream mode: Converts a tar stream of NNNNNN.bin files on stdin into a tar stream of the output tree on stdout
+ *
+ * One file at a time through a single input and output buffer, so the memory use doesn't grow with the input and
+ * nothing touches the disk. Other members of the input get skipped, just like other files in an input folder.
+ */
+static int streamRun(const CONFIG *config, bool inflate, STATS *stats, TRACE *trace)
+{
+    ARCHIVE archive;
+    archiveOpenFd(&archive, STDOUT_FILENO);
+    FILE_LIST list = {
+        .path = "",
+        .pathLength = 0,
+        .names = NULL,
+        .count = 0,
+        .config = config,
+        .jobs = NULL,
+        .writeIfChanged = false,
+        .archive = &archive,
+    };
+
+    OUTPUT out = {
+        .write = archiveOutput,
+        .ctx = &list,
+        .strtab = NULL,
+        .stats = stats,
+        .trace = trace,
+    };
+
+    emitterInit(&out.buf);
+    ARCHIVE_READER in;
+    archiveReaderInit(&in, STDIN_FILENO);
+    uint8_t blob[INPUT_MAX];
+    uint8_t packed[INPUT_MAX];
+    char file[256];
+    int ret = archiveOutputDirs(&archive) ? 0 : 1;
+    while(ret == 0)
+    {
+        ssize_t filesize = -1;
+        PHASE prev = statsEnter(stats, PHASE_READ);
+        size_t span = traceBegin(trace, "read", -1, NULL);
+        int next = archiveNext(&in, file, sizeof(file), inflate ? packed : blob, INPUT_MAX, &filesize);
+        traceEnd(trace, span);
+        statsEnter(stats, prev);
+        if(next != 1)
+        {
+            ret = next == 0 ? 0 : 1;
+            break;
+        }
+
+        // Same rules as for the files in an input folder
+        const char *base = strrchr(file, '/');
+        base = base != NULL ? base + 1 : file;
+        if(base[0] == '.' || strlen(base) != 6 + 1 + 3 || memcmp(base + 6, ".bin", 4) != 0)
+            continue;
+
+        char name[6 + 1];
+        memcpy(name, base, 6);
+        name[6] = '\0';
+        PROBE1(process__entry, name);
+        span = traceBegin(trace, "file", -1, name);
+        if(inflate && filesize < INPUT_MAX)
+            filesize = unpackInput(file, packed, filesize, blob, &out);
+
+        ret = filesize != -1 ? convertBlob(name, file, config, blob, filesize, &out, NULL) : 1;
+        traceEnd(trace, span);
+        PROBE3(process__return, name, filesize, ret);
+    }
+
+    if(!archiveClose(&archive))
+        ret = 1;
+
+    emitterFree(&out.buf);
+    return ret;
+}
+
+/* Writes the timeline and the report of a run, returns ret or 1 if the timeline couldn't be written */
+static int finishRun(int ret, FILE *status, TRACE_FILE *traceOut, TRACE *mainTrace, STATS *stats, uint64_t start, unsigned int threads, unsigned int convert)
+{
+    if(traceOut != NULL)
+    {
+        traceAppend(traceOut, mainTrace, 0, "main");
+        if(!traceClose(traceOut))
+            ret = 1;
+    }
+
+    traceFree(mainTrace);
+    if(ret == 0)
+        fprintf(status, "Done\n");
+
+    if(stats != NULL)
+    {
+        statsEnter(stats, PHASE_OTHER);
+        statsWrite(stats, status, statsNow() - start, threads, convert);
+    }
+
+    return ret;
+}
+
+static int compareNames(const void *a, const void *b)
+{
+    return memcmp(a, b, 6);
+}
+
+static int compareKeys(const void *a, const void *b)
+{
+    uint32_t ka = *(const uint32_t *)a;
+    uint32_t kb = *(const uint32_t *)b;
+    return (ka > kb) - (ka < kb);
+}
+
+/* Maps the whole --image file read-only */
+static bool mapImage(const char *file, const uint8_t **data, size_t *size)
+{
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+    {
+        fprintf(stderr, "%s not found\n", file);
+        return false;
+    }
+
+    struct stat st;
+    void *map = MAP_FAILED;
+    if(fstat(fd, &st) == 0)
+    {
+        if(st.st_size == 0)
+            errno = EINVAL;
+        else
+            map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    bool ret = map != MAP_FAILED;
+    if(ret)
+    {
+        madvise(map, st.st_size, MADV_WILLNEED);
+        *data = map;
+        *size = st.st_size;
+    }
+    else
+        fprintf(stderr, "Error mapping %s: %s\n", file, strerror(errno));
+
+    close(fd);
+    return ret;
+}
+
+/*
+ * --image: Lists the inputs, every offset in the dictionary is one
+ *
+ * They get sorted by offset, so the workers walk the image front to back. If there's a sidecar index next to the
+ * image (image.idx, one "XXXXXX size" line per asset, offset in hex and size in decimal) the sizes are taken as an
+ * upper bound for the assets, the others are only bound by the end of the image.
+ */
+static bool imageAssets(FILE_LIST *list, const DICTIONARY *dic, const char *imageFile)
+{
+    size_t count = 0;
+    for(int i = 0; i < DIC_TYPES; i++)
+        count += dictionarySize(dic, i);
+
+    uint32_t *keys = malloc(sizeof(uint32_t) * count);
+    list->names = malloc(count * 6);
+    if(keys == NULL || list->names == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        free(keys);
+        return false;
+    }
+
+    count = 0;
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        for(uint32_t j = 0; j < dictionarySize(dic, i); j++)
+        {
+            uint16_t value;
+            dictionaryEntry(dic, i, j, keys + count++, &value);
+        }
+    }
+
+    qsort(keys, count, sizeof(uint32_t), compareKeys);
+    list->count = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        if(i != 0 && keys[i] == keys[i - 1])
+            continue;
+
+        char name[6 + 1];
+        snprintf(name, sizeof(name), "%06X", keys[i]);
+        memcpy(list->names[list->count++], name, 6);
+    }
+
+    free(keys);
+
+    size_t fl = strlen(imageFile);
+    char idxFile[fl + sizeof(".idx")];
+    memcpy(idxFile, imageFile, fl);
+    memcpy(idxFile + fl, ".idx", sizeof(".idx"));
+    FILE *idx = fopen(idxFile, "r");
+    if(idx == NULL)
+        return true;
+
+    bool ret = true;
+    list->lengths = malloc(sizeof(uint32_t) * list->count);
+    if(list->lengths == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        ret = false;
+    }
+    else
+    {
+        memset(list->lengths, 0xFF, sizeof(uint32_t) * list->count);
+        unsigned int offset, length;
+        char name[6 + 1];
+        while(fscanf(idx, "%x %u", &offset, &length) == 2)
+        {
+            snprintf(name, sizeof(name), "%06X", offset & 0xFFFFFF);
+            char (*found)[6] = bsearch(name, list->names, list->count, 6, compareNames);
+            if(found != NULL)
+                list->lengths[found - list->names] = length;
+        }
+
+        if(!feof(idx))
+        {
+            fprintf(stderr, "Error reading %s\n", idxFile);
+            ret = false;
+        }
+    }
+
+    fclose(idx);
+    return ret;
+}
+
+/* Records the output name the dictionary of this run gives an input */
+static void mapOutput(const FILE_LIST *list, MANIFEST_ENTRY *entry)
+{
+    char outName[4];
+    int32_t value = entry->type < DIC_TYPES ? mapName(list->config->dic, entry->type, entry->name, outName) : DIC_MISS;
+    entry->mapped = value != DIC_MISS;
+    entry->output = value != DIC_MISS ? value : 0;
+}
+
+/* Removes the output files of an input recorded in the manifest, by the name they got written with */
+static void removeOutputs(const FILE_LIST *list, const MANIFEST_ENTRY *entry)
+{
+    if(entry->type >= DIC_TYPES || !entry->mapped)
+        return;
+
+    char file[sizeof("XXXX.grunty_q")];
+    snprintf(file, sizeof(file), "%04X.%s", entry->output, typeDir[entry->type]);
+    for(int i = 0; i < 3; i++)
+        if(unlinkat(list->outDirs[i][entry->type], file, 0) == -1 && errno != ENOENT)
+            fprintf(stderr, "Error removing %s/%s/%s: %s\n", lang[i], typeDir[entry->type], file, strerror(errno));
+}
+
+/*
+ * Incremental mode: Compares the inputs with the manifest of the last run
+ *
+ * Inputs with the same size and mtime as last time go straight into current, the others stay in the list and get a job.
+ * Outputs of inputs which are gone and outputs a changed dictionary renamed get removed.
+ */
+static bool selectChanged(FILE_LIST *list, int inDir, const MANIFEST *previous, MANIFEST *current)
+{
+    qsort(list->names, list->count, 6, compareNames);
+    current->entries = malloc(sizeof(MANIFEST_ENTRY) * list->count);
+    list->jobs = malloc(sizeof(MANIFEST_JOB) * list->count);
+    if(list->count != 0 && (current->entries == NULL || list->jobs == NULL))
+    {
+        fprintf(stderr, "Out of memory\n");
+        return false;
+    }
+
+    // Both lists are sorted, so the gone ones are found while walking them
+    size_t p = 0, changed = 0;
+    for(size_t i = 0; i < list->count; i++)
+    {
+        for(; p < previous->header.count && memcmp(previous->entries[p].name, list->names[i], 6) < 0; p++)
+            removeOutputs(list, previous->entries + p);
+
+        const MANIFEST_ENTRY *prev = NULL;
+        if(p < previous->header.count && memcmp(previous->entries[p].name, list->names[i], 6) == 0)
+            prev = previous->entries + p++;
+
+        // With another dictionary the input may get another name, its outputs under the old one have to go first
+        bool renamed = false;
+        if(prev != NULL && prev->mapped)
+        {
+            MANIFEST_ENTRY now = *prev;
+            mapOutput(list, &now);
+            renamed = !now.mapped || now.output != prev->output;
+            if(renamed)
+                removeOutputs(list, prev);
+        }
+
+        char file[6 + 4 + 1];
+        memcpy(file, list->names[i], 6);
+        memcpy(file + 6, ".bin", sizeof(".bin"));
+        struct stat st;
+        int64_t mtime = -1;
+        if(fstatat(inDir, file, &st, 0) == 0)
+            mtime = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+        else
+            st.st_size = 0;
+
+        if(prev != NULL && !renamed && mtime != -1 && (off_t)prev->size == st.st_size && prev->mtime == mtime)
+        {
+            current->entries[current->header.count++] = *prev;
+            continue;
+        }
+
+        // Not checked yet, the worker fills in the rest after reading it
+        MANIFEST_JOB *job = list->jobs + changed;
+        memset(job, 0, sizeof(MANIFEST_JOB));
+        memcpy(job->entry.name, list->names[i], 6);
+        job->entry.mtime = mtime;
+        job->entry.size = st.st_size;
+        job->previous = renamed ? NULL : prev; // Renamed ones get converted even if their content didn't change
+        memmove(list->names[changed++], list->names[i], 6);
+    }
+
+    for(; p < previous->header.count; p++)
+        removeOutputs(list, previous->entries + p);
+
+    printf("%zu of %zu files changed\n", changed, list->count);
+    list->count = changed;
+    return true;
+}
+
+/* Incremental mode: Adds the converted files to the manifest and writes it */
+static bool finishChanged(const FILE_LIST *list, MANIFEST *current)
+{
+    for(size_t i = 0; i < list->count; i++)
+    {
+        const MANIFEST_JOB *job = list->jobs + i;
+
+        // Outputs of the old type would be left behind otherwise
+        if(job->previous != NULL && job->previous->type != job->entry.type)
+            removeOutputs(list, job->previous);
+
+        current->entries[current->header.count] = job->entry;
+        mapOutput(list, current->entries + current->header.count++);
+    }
+
+    return manifestWrite(current, MANIFEST_FILE);
+}
+
+/*
+ * Merges the messages collected by the workers into one string table per language
+ *
+ * They're written as XX.strtab next to the XX folders respectively into the archive.
+ */
+static bool writeStrtabs(const FILE_LIST *list, WORKER *workers, long threads)
+{
+    STRTAB_BUILDER builders[threads];
+    for(long i = 0; i < threads; i++)
+        builders[i] = workers[i].strtab;
+
+    EMITTER buf;
+    emitterInit(&buf);
+    bool ret = true;
+    for(int i = 0; ret && i < 3; i++)
+    {
+        char file[sizeof("XX.strtab")];
+        snprintf(file, sizeof(file), "%s.strtab", lang[i]);
+        ret = strtabBuild(builders, threads, i, &buf);
+        if(!ret)
+            break;
+
+        if(list->archive != NULL)
+        {
+            ret = archiveAdd(list->archive, file, buf.data, buf.size);
+            continue;
+        }
+
+        int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        ret = fd != -1 && emitterFlush(&buf, fd);
+        if(fd != -1 && close(fd) == -1)
+            ret = false;
+
+        if(!ret)
+            fprintf(stderr, "Error writing %s\n", file);
+    }
+
+    emitterFree(&buf);
+    return ret;
+}
+
+static void showHelp(char *prog)
+{
+    fprintf(stderr, "Usage: %s [-u|-i|-r]  [-w|-c|-n] [-j threads] [--charset name] [--dict file] [--io-uring depth] [--incremental] [--write-if-changed] [--archive file] [--strtab] [--stats] [--trace file] [--inflate] [--pipeline r,p,w] input/path|--stream|--image file\n"
+                    "       %s [-u|-i|-r]  [-w|-c|-n] [-j threads] [--charset name] [--dict file] --encode yaml/path\n"
+                    "       %s [--dict file] --make-dict file\n"
+                    "\t-u: Convert strings to UTF-8 (default)\n"
+                    "\t-i: Convert strings to ISO-8859-1\n"
+                    "\t-r: Dump strings raw (RARE character table)\n"
+                    "\t--charset: Character table of the game version to convert from (default: " CHARSET_DEFAULT ")\n"
+                    "\t-w: Add control bytes (\"\\xFDl\") to beginning of answers (needed by Banjo: Recompiled but missing in PAL ROM)\n"
+                    "\t-c: Add compressed control bytes (same as above but instead of writing as escape codes write them binary) (default)\n"
+                    "\t-n: Don't add control bytes (see above)\n"
+                    "\t-j: Number of worker threads (default: 1, 0: one per CPU core)\n"
+                    "\t--dict: Load the filename mappings from a dictionary file instead of using the built-in ones\n"
+                    "\t--make-dict: Write the filename mappings to a dictionary file and exit\n"
+                    "\t--io-uring: Use batched io_uring I/O with up to depth files in flight per worker thread\n"
+                    "\t--incremental: Only convert files changed since the last run and remove outputs of deleted ones (see " MANIFEST_FILE ")\n"
+                    "\t--write-if-changed: Leave output files with the same content untouched, replace the others atomically\n"
+                    "\t--archive: Write all output files into a single tar archive instead of the current folder\n"
+                    "\t--strtab: Also write a binary string table for each language (XX.strtab, see strtab.h)\n"
+                    "\t--stats: Print timings per phase and counters per file type as a single line of JSON at the end\n"
+                    "\t--trace: Write a timeline of every file and phase per thread to file, in the Chrome trace-event format (Perfetto)\n"
+                    "\t--stream: Read a tar archive of .bin files from stdin and write a tar archive of the output tree to stdout, messages go to stderr\n"
+                    "\t--image: Convert straight from a packed asset image at the offsets named by the dictionary, file.idx next to it can bound the sizes\n"
+                    "\t--inflate: The inputs are compressed, raw deflate or with Rare-zip header, and get unpacked by the workers\n"
+                    "\t--pipeline: Instead of -j run r reader, p parser and w writer threads connected by bounded queues\n"
+                    "\t--encode: Turn the YAML files below yaml/path (as written with the same options) back into .bin files in the current folder\n", prog, prog, prog);
+}
+
+/*
+ * Entry function of the program
+ *
+ * It accepts the options from showHelp() and exactly one argument: A path containing .bin files
+ */
+int main(int argc, char *argv[])
+{
+    // Check if argument is there
+    if(argc < 2)
+    {
+        showHelp(argv[0]);
+        return 1;
+    }
+
+    unsigned int convert = TO_UTF | TO_CON | TO_COM;
+    long threads = 1;
+    const char *path = NULL;
+    const char *dictFile = NULL;
+    const char *makeDict = NULL;
+    const char *uring = NULL;
+    const char *charsetName = CHARSET_DEFAULT;
+    const char *archiveFile = NULL;
+    const char *traceFile = NULL;
+    const char *imageFile = NULL;
+    const char *pipeline = NULL;
+    bool incremental = false;
+    bool writeIfChanged = false;
+    bool strtab = false;
+    bool encode = false;
+    bool stats = false;
+    bool stream = false;
+    bool inflate = false;
+    for(int i = 1; i < argc; i++)
+    {
+        if(argv[i][0] != '-')
+        {
+            if(path != NULL)
+            {
+                showHelp(argv[0]);
+                return 1;
+            }
+
+            path = argv[i];
+            continue;
+        }
+
+        if(strcmp(argv[i], "--incremental") == 0)
+        {
+            incremental = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "--write-if-changed") == 0)
+        {
+            writeIfChanged = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "--strtab") == 0)
+        {
+            strtab = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "--encode") == 0)
+        {
+            encode = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "--stats") == 0)
+        {
+            stats = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "--stream") == 0)
+        {
+            stream = true;
+            continue;
+        }
+
+        if(strcmp(argv[i], "--inflate") == 0)
+        {
+            inflate = true;
+            continue;
+        }
+
+        if(argv[i][1] == '-')
+        {
+            const char **value;
+            if(strcmp(argv[i], "--dict") == 0)
+                value = &dictFile;
+            else if(strcmp(argv[i], "--make-dict") == 0)
+                value = &makeDict;
+            else if(strcmp(argv[i], "--io-uring") == 0)
+                value = &uring;
+            else if(strcmp(argv[i], "--charset") == 0)
+                value = &charsetName;
+            else if(strcmp(argv[i], "--archive") == 0)
+                value = &archiveFile;
+            else if(strcmp(argv[i], "--trace") == 0)
+                value = &traceFile;
+            else if(strcmp(argv[i], "--image") == 0)
+                value = &imageFile;
+            else if(strcmp(argv[i], "--pipeline") == 0)
+                value = &pipeline;
+            else
+            {
+                showHelp(argv[0]);
+                return 1;
+            }
+
+            if(++i == argc)
+            {
+                showHelp(argv[0]);
+                return 1;
+            }
+
+            *value = argv[i];
+            continue;
+        }
+
+        if(argv[i][1] == '\0' || argv[i][2] != '\0')
+        {
+            showHelp(argv[0]);
+            return 1;
+        }
+
+        switch(argv[i][1])
+        {
+            case 'i':
+                convert &= ~(TO_UTF);
+                convert |= TO_ISO;
+                break;
+            case 'u':
+                convert &= ~(TO_ISO);
+                convert |= TO_UTF;
+                break;
+            case 'r':
+                convert &= ~(TO_UTF | TO_ISO);
+                break;
+            case 'w':
+                convert &= ~(TO_COM);
+                convert |= TO_CON;
+                break;
+            case 'c':
+                convert |= TO_CON | TO_COM;
+                break;
+            case 'n':
+                convert &= ~(TO_CON | TO_COM);
+                break;
+            case 'j':
+            {
+                char *end;
+                if(++i == argc || (threads = strtol(argv[i], &end, 10)) < 0 || *end != '\0' || end == argv[i])
+                {
+                    showHelp(argv[0]);
+                    return 1;
+                }
+
+                if(threads == 0)
+                    threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+                break;
+            }
+            default:
+                showHelp(argv[0]);
+                return 1;
+        }
+    }
+
+    if(archiveFile != NULL && (uring != NULL || incremental || writeIfChanged))
+    {
+        fprintf(stderr, "--archive can't be combined with --io-uring, --incremental nor --write-if-changed\n");
+        return 1;
+    }
+
+    if(stream && (path != NULL || archiveFile != NULL || uring != NULL || incremental || writeIfChanged || strtab || encode))
+    {
+        fprintf(stderr, "--stream takes no input path and can't be combined with --archive, --io-uring, --incremental, --write-if-changed, --strtab nor --encode\n");
+        return 1;
+    }
+
+    if(imageFile != NULL && (path != NULL || stream || uring != NULL || incremental || encode))
+    {
+        fprintf(stderr, "--image takes no input path and can't be combined with --stream, --io-uring, --incremental nor --encode\n");
+        return 1;
+    }
+
+    if(encode && (archiveFile != NULL || uring != NULL || incremental || writeIfChanged || strtab || stats || traceFile != NULL))
+    {
+        fprintf(stderr, "--encode can't be combined with --archive, --io-uring, --incremental, --write-if-changed, --strtab, --stats nor --trace\n");
+        return 1;
+    }
+
+    // The io_uring backend reads straight into the parser's buffers
+    if(inflate && (uring != NULL || encode))
+    {
+        fprintf(stderr, "--inflate can't be combined with --io-uring nor --encode\n");
+        return 1;
+    }
+
+    // The stages are reader, parser and writer threads over the files of an input folder
+    unsigned int stages[STAGES] = { 0 };
+    if(pipeline != NULL)
+    {
+        if(uring != NULL || stream || imageFile != NULL || encode)
+        {
+            fprintf(stderr, "--pipeline can't be combined with --io-uring, --stream, --image nor --encode\n");
+            return 1;
+        }
+
+        const char *value = pipeline;
+        for(int i = 0; i < STAGES; i++)
+        {
+            char *end;
+            long count = strtol(value, &end, 10);
+            if(end == value || count < 1 || count > PIPELINE_MAX_THREADS || *end != (i == STAGES - 1 ? '\0' : ','))
+            {
+                showHelp(argv[0]);
+                return 1;
+            }
+
+            stages[i] = count;
+            value = end + 1;
+        }
+    }
+
+    // The string tables get built from the parsed files, so they'd miss the ones skipped
+    if(strtab && (uring != NULL || incremental))
+    {
+        fprintf(stderr, "--strtab can't be combined with --io-uring nor --incremental\n");
+        return 1;
+    }
+
+    long uringDepth = 0;
+    if(uring != NULL)
+    {
+        if(writeIfChanged)
+        {
+            fprintf(stderr, "--write-if-changed can't be combined with --io-uring\n");
+            return 1;
+        }
+
+#ifdef HAVE_IO_URING
+        char *end;
+        uringDepth = strtol(uring, &end, 10);
+        if(*end != '\0' || end == uring || uringDepth < 1 || uringDepth > URING_MAX_DEPTH)
+        {
+            showHelp(argv[0]);
+            return 1;
+        }
+#else
+        fprintf(stderr, "%s was built without io_uring support\n", argv[0]);
+        return 1;
+#endif
+    }
+
+    const CHARSET *charset = charsetFind(charsetName);
+    if(charset == NULL)
+    {
+        fprintf(stderr, "Unknown charset %s, available:", charsetName);
+        for(size_t i = 0; i < charsetCount; i++)
+            fprintf(stderr, " %s", charsets[i].name);
+
+        fprintf(stderr, "\n");
+        return 1;
+    }
+
+    DICTIONARY dic;
+    dictionaryInit(&dic);
+    if(dictFile != NULL && !dictionaryLoad(&dic, dictFile))
+        return 1;
+
+    if(makeDict != NULL)
+    {
+        int ret = dictionaryWrite(&dic, makeDict) ? 0 : 1;
+        dictionaryUnload(&dic);
+        return ret;
+    }
+
+    if(path == NULL && !stream && imageFile == NULL)
+    {
+        showHelp(argv[0]);
+        dictionaryUnload(&dic);
+        return 1;
+    }
+
+    CONFIG config = {
+        .convert = convert,
+        .dic = &dic,
+        .charset = charset,
+    };
+
+    if(threads < 1)
+        threads = 1;
+
+    // With --pipeline the workers are the parser stage
+    if(pipeline != NULL)
+        threads = stages[STAGE_PARSE];
+
+    if(encode)
+    {
+        if(convert & TO_UTF)
+            printf("Encoding strings from UTF-8");
+        else if(convert & TO_ISO)
+            printf("Encoding strings from ISO-8859-1");
+        else
+            printf("Taking strings raw (RARE character table)");
+
+        if(convert & TO_CON)
+            printf(" (removing control bytes from answers)");
+
+        printf("\n");
+        int ret = encodeRun(path, &config, threads);
+        dictionaryUnload(&dic);
+        if(ret == 0)
+            printf("Done\n");
+
+        return ret;
+    }
+
+    // In stream mode stdout is the output archive
+    FILE *status = stream ? stderr : stdout;
+    if(convert & TO_UTF)
+        fprintf(status, "Converting strings to UTF-8");
+    else if(convert & TO_ISO)
+        fprintf(status, "Converting strings to ISO-8859-1");
+    else
+        fprintf(status, "Dumping strings raw (RARE character table)");
+
+    if(convert & TO_CON)
+        fprintf(status, " (adding control bytes to answers)");
+
+    fprintf(status, "\n");
+
+    // The main thread books the scan, the output tree and the final writes, the workers merge theirs in
+    STATS total;
+    statsInit(&total);
+    STATS *mainStats = stats ? &total : NULL;
+    uint64_t start = total.mark;
+
+    // Same for the timeline
+    TRACE_FILE traceOut;
+    TRACE mainTrace;
+    traceInit(&mainTrace);
+    TRACE *trace = traceFile != NULL ? &mainTrace : NULL;
+    if(traceFile != NULL && !traceOpen(&traceOut, traceFile))
+    {
+        dictionaryUnload(&dic);
+        return 1;
+    }
+
+    if(stream)
+    {
+        int ret = streamRun(&config, inflate, mainStats, trace);
+        dictionaryUnload(&dic);
+        return finishRun(ret, status, trace != NULL ? &traceOut : NULL, &mainTrace, mainStats, start, 1, convert);
+    }
+
+    // Open directory respectively map the image
+    statsEnter(mainStats, PHASE_SCAN);
+    size_t span = traceBegin(trace, "scan", -1, NULL);
+    DIR *folder = NULL;
+    const uint8_t *image = NULL;
+    size_t imageSize = 0;
+    if(imageFile != NULL ? !mapImage(imageFile, &image, &imageSize) : (folder = opendir(path)) == NULL)
+    {
+        if(imageFile == NULL)
+            fprintf(stderr, "Error opening %s\n", path);
+
+        if(trace != NULL)
+            traceClose(&traceOut);
+
+        traceFree(&mainTrace);
+        dictionaryUnload(&dic);
+        return 1;
+    }
+
+    traceEnd(trace, span);
+
+    // Create a path array containing the folder + '/', the workers append the filenames to it
+    if(imageFile != NULL)
+        path = imageFile;
+
+    size_t sl = strlen(path);
+    char dirPath[sl + 1];
+    memcpy(dirPath, path, sl);
+    dirPath[sl++] = '/';
+
+    FILE_LIST list = {
+        .path = dirPath,
+        .pathLength = sl,
+        .names = NULL,
+        .count = 0,
+        .config = &config,
+        .jobs = NULL,
+        .writeIfChanged = writeIfChanged,
+        .archive = NULL,
+        .image = image,
+        .imageSize = imageSize,
+        .lengths = NULL,
+        .inflate = inflate,
+    };
+
+    // Create the output tree respectively the archive
+    statsEnter(mainStats, PHASE_MKDIR);
+    span = traceBegin(trace, "mkdir", -1, NULL);
+    int ret = 0;
+    ARCHIVE archive;
+    memset(list.outDirs, -1, sizeof(list.outDirs));
+    if(archiveFile != NULL)
+    {
+        if(archiveOpen(&archive, archiveFile))
+        {
+            list.archive = &archive;
+            if(!archiveOutputDirs(&archive))
+                ret = 1;
+        }
+        else
+            ret = 1;
+    }
+    else if(!openOutputDirs(list.outDirs))
+        ret = 1;
+
+    // Loop over all files in the folder and collect the names of the .bin files
+    traceEnd(trace, span);
+    statsEnter(mainStats, PHASE_SCAN);
+    span = traceBegin(trace, "scan", -1, NULL);
+    size_t capacity = 0;
+    struct dirent *entry;
+    while (ret == 0 && folder != NULL && (entry = readdir(folder)) != NULL) {
+        // Check if file is not hidden, is a real file, filename is 10 chars long (including extension) and extension is .bin. Skip otherwise
+        if(entry->d_name[0] == '.' || entry->d_type != DT_REG || strlen(entry->d_name) != 6 + 1 + 3 /* filename + '.' + extension */ || memcmp(entry->d_name + 6, ".bin", 4) != 0)
+            continue;
+
+        if(list.count == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 1024;
+            char (*names)[6] = realloc(list.names, capacity * 6);
+            if(names == NULL)
+            {
+                fprintf(stderr, "Out of memory\n");
+                ret = 1;
+                break;
+            }
+
+            list.names = names;
+        }
+
+        memcpy(list.names[list.count++], entry->d_name, 6);
+    }
+
+    if(ret == 0 && image != NULL && !imageAssets(&list, &dic, imageFile))
+        ret = 1;
+
+    // In incremental mode drop the unchanged files from the list
+    MANIFEST previous, current;
+    manifestInit(&previous, &config);
+    manifestInit(&current, &config);
+    if(ret == 0 && incremental)
+    {
+        manifestLoad(&previous, MANIFEST_FILE);
+        if(!selectChanged(&list, dirfd(folder), &previous, &current))
+            ret = 1;
+    }
+
+    // Process the files. Each worker gets a pointer to the shared list and its own buffers
+    traceEnd(trace, span);
+    statsEnter(mainStats, PHASE_OTHER);
+    if(ret == 0 && uringDepth != 0)
+    {
+#ifdef HAVE_IO_URING
+        ret = uringRun(dirfd(folder), dirPath, sl, list.names, list.jobs, list.count, &config, list.outDirs, uringDepth, threads, mainStats, trace ? &traceOut : NULL);
+        statsSkip(mainStats);
+#endif
+    }
+    else if(ret == 0)
+    {
+        WORKER *workers = malloc(sizeof(WORKER) * threads);
+        if(workers != NULL)
+        {
+            for(long i = 0; i < threads; i++)
+            {
+                workers[i].list = &list;
+                emitterInit(&workers[i].out.buf);
+                workers[i].out.write = list.archive ? archiveOutput : writeOutput;
+                workers[i].out.ctx = &list;
+                workers[i].out.strtab = NULL;
+                if(strtab)
+                {
+                    strtabInit(&workers[i].strtab);
+                    workers[i].out.strtab = &workers[i].strtab;
+                }
+
+                statsInit(&workers[i].stats);
+                workers[i].out.stats = stats ? &workers[i].stats : NULL;
+                traceInit(&workers[i].trace);
+                workers[i].out.trace = trace ? &workers[i].trace : NULL;
+            }
+
+            if(pipeline != NULL)
+                ret = pipelineRun(&list, workers, stages, mainStats, trace ? &traceOut : NULL);
+            else
+                ret = poolRun(list.count, threads, processJob, workers, sizeof(WORKER));
+
+            statsSkip(mainStats);
+            statsEnter(mainStats, PHASE_WRITE);
+            span = strtab ? traceBegin(trace, "strtab", -1, NULL) : TRACE_NONE;
+            if(ret == 0 && strtab && !writeStrtabs(&list, workers, threads))
+                ret = 1;
+
+            traceEnd(trace, span);
+            for(long i = 0; i < threads; i++)
+            {
+                statsMerge(&total, &workers[i].stats);
+                if(trace != NULL)
+                {
+                    char threadName[32];
+                    snprintf(threadName, sizeof(threadName), pipeline != NULL ? "parser %ld" : "worker %ld", i);
+                    traceAppend(&traceOut, &workers[i].trace, i + 1, threadName);
+                }
+
+                traceFree(&workers[i].trace);
+                emitterFree(&workers[i].out.buf);
+                if(strtab)
+                    strtabFree(&workers[i].strtab);
+            }
+
+            free(workers);
+        }
+        else
+        {
+            fprintf(stderr, "Out of memory\n");
+            ret = 1;
+        }
+    }
+
+    // Only record the run if everything went fine, otherwise the next one will look at the same files again
+    statsEnter(mainStats, PHASE_WRITE);
+    span = traceBegin(trace, "finish", -1, NULL);
+    if(ret == 0 && incremental && !finishChanged(&list, &current))
+        ret = 1;
+
+    if(list.archive != NULL && !archiveClose(list.archive))
+        ret = 1;
+
+    traceEnd(trace, span);
+    manifestFree(&previous);
+    manifestFree(&current);
+    free(list.jobs);
+
+    // Exit the program
+    if(folder != NULL)
+        closedir(folder);
+
+    if(image != NULL)
+        munmap((void *)image, imageSize);
+
+    free(list.lengths);
+    free(list.names);
+    closeOutputDirs(list.outDirs);
+    dictionaryUnload(&dic);
+    return finishRun(ret, status, trace != NULL ? &traceOut : NULL, &mainTrace, mainStats, start, threads + stages[STAGE_READ] + stages[STAGE_WRITE], convert);
 }
@@ -0,0 +1,156 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "manifest.h"
+
+/* FNV-1a, 64 bit */
+static uint64_t hash(const uint8_t *data, size_t size)
+{
+    uint64_t h = 0xCBF29CE484222325;
+    for(size_t i = 0; i < size; i++)
+    {
+        h ^= data[i];
+        h *= 0x00000100000001B3;
+    }
+
+    return h;
+}
+
+static int compareEntries(const void *a, const void *b)
+{
+    return memcmp(((const MANIFEST_ENTRY *)a)->name, ((const MANIFEST_ENTRY *)b)->name, 6);
+}
+
+/* Sets up an empty manifest for the given settings */
+void manifestInit(MANIFEST *m, const CONFIG *config)
+{
+    memset(m, 0, sizeof(MANIFEST));
+    memcpy(m->header.magic, MANIFEST_MAGIC, 4);
+    m->header.version = MANIFEST_VERSION;
+    m->header.convert = config->convert;
+    m->header.dictionary = config->dic->checksum;
+    m->header.charset = hash((const uint8_t *)config->charset->name, strlen(config->charset->name));
+}
+
+/*
+ * Loads the entries of a manifest file into an empty manifest
+ *
+ * A missing or invalid file leaves the manifest empty, so everything gets converted. Of one written with other
+ * settings only the names, types and output names are kept: No input matches them, but the outputs of inputs which
+ * are gone or got another name still get removed.
+ */
+void manifestLoad(MANIFEST *m, const char *file)
+{
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if(fd == -1)
+    {
+        if(errno != ENOENT)
+            fprintf(stderr, "Error opening %s: %s\n", file, strerror(errno));
+
+        return;
+    }
+
+    MANIFEST_HEADER hdr;
+    struct stat st;
+    if(fstat(fd, &st) == -1 || read(fd, &hdr, sizeof(hdr)) != sizeof(hdr) || memcmp(hdr.magic, MANIFEST_MAGIC, 4) != 0 ||
+       hdr.version != MANIFEST_VERSION || sizeof(hdr) + (size_t)hdr.count * sizeof(MANIFEST_ENTRY) != (size_t)st.st_size)
+    {
+        fprintf(stderr, "Ignoring invalid manifest %s\n", file);
+        close(fd);
+        return;
+    }
+
+    size_t size = (size_t)hdr.count * sizeof(MANIFEST_ENTRY);
+    m->entries = malloc(size);
+    if(m->entries == NULL || read(fd, m->entries, size) != (ssize_t)size)
+    {
+        fprintf(stderr, "Error reading %s\n", file);
+        free(m->entries);
+        m->entries = NULL;
+        close(fd);
+        return;
+    }
+
+    m->header.count = hdr.count;
+    if(hdr.convert != m->header.convert || hdr.dictionary != m->header.dictionary || hdr.charset != m->header.charset)
+    {
+        printf("Settings changed since the last run, converting everything\n");
+        for(uint32_t i = 0; i < hdr.count; i++)
+        {
+            m->entries[i].size = MANIFEST_NO_SIZE;
+            m->entries[i].hash = 0;
+        }
+    }
+
+    close(fd);
+}
+
+void manifestFree(MANIFEST *m)
+{
+    free(m->entries);
+    m->entries = NULL;
+    m->header.count = 0;
+}
+
+/*
+ * Sorts the entries and writes the manifest
+ *
+ * It gets written to a temporary file first and then renamed, so an interrupted run leaves the old manifest intact.
+ */
+bool manifestWrite(MANIFEST *m, const char *file)
+{
+    qsort(m->entries, m->header.count, sizeof(MANIFEST_ENTRY), compareEntries);
+
+    size_t fl = strlen(file);
+    char tmp[fl + sizeof(".tmp")];
+    memcpy(tmp, file, fl);
+    memcpy(tmp + fl, ".tmp", sizeof(".tmp"));
+
+    bool ret = false;
+    FILE *f = fopen(tmp, "wb");
+    if(f != NULL)
+    {
+        ret = fwrite(&m->header, sizeof(MANIFEST_HEADER), 1, f) == 1 &&
+              fwrite(m->entries, sizeof(MANIFEST_ENTRY), m->header.count, f) == m->header.count;
+
+        ret = fclose(f) == 0 && ret;
+        ret = ret && rename(tmp, file) == 0;
+    }
+
+    if(!ret)
+    {
+        fprintf(stderr, "Error writing %s\n", file);
+        unlink(tmp);
+    }
+
+    return ret;
+}
+
+/* Binary search for an entry, name is the 6 char filename without extension */
+const MANIFEST_ENTRY *manifestFind(const MANIFEST *m, const char *name)
+{
+    MANIFEST_ENTRY key;
+    memcpy(key.name, name, 6);
+    return bsearch(&key, m->entries, m->header.count, sizeof(MANIFEST_ENTRY), compareEntries);
+}
+
+/*
+ * Called by the workers after reading an input: Records the content hash and type of the blob as parsed
+ *
+ * The size in the entry stays what the caller recorded from stat(), the size on disk. With --inflate that's the
+ * compressed size, so the next run can skip the file by size and mtime without unpacking it.
+ * Returns false if the content didn't change since the last run, so it doesn't need to be converted again.
+ */
+bool manifestUpdate(MANIFEST_JOB *job, const uint8_t *blob, size_t size)
+{
+    job->entry.hash = hash(blob, size);
+    job->entry.type = blobType(blob);
+
+    const MANIFEST_ENTRY *prev = job->previous;
+    return prev == NULL || prev->size != job->entry.size || prev->hash != job->entry.hash;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "convert.h"
+
+/*
+ * Manifest of an incremental run, kept in the output folder
+ *
+ * It records what the inputs looked like when they were converted the last time, so the next run with --incremental
+ * can skip the ones that didn't change. The header is followed by the entries, sorted by name. All numbers are little endian.
+ * A manifest written with other settings (conversion flags, dictionary, charset) doesn't count, everything gets converted again.
+ * Its list of inputs is still used to remove the outputs of the ones which are gone.
+ */
+#define MANIFEST_FILE ".diagConv.manifest"
+#define MANIFEST_MAGIC "DCMF"
+#define MANIFEST_VERSION 2
+#define MANIFEST_NO_SIZE UINT32_MAX // Size of the entries of a manifest with other settings, no input has it
+
+typedef struct __attribute__((__packed__))
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t convert;
+    uint32_t dictionary;
+    uint32_t charset;
+    uint32_t count;
+} MANIFEST_HEADER;
+
+typedef struct __attribute__((__packed__))
+{
+    char name[6];
+    uint8_t type; // DIC_TYPE of the input
+    uint8_t mapped; // Whether the dictionary had an output name for it
+    uint16_t output; // The output name (XXXX.dialog/...) when it got converted, its outputs get removed by this
+    uint32_t size; // On disk, before --inflate unpacks it
+    int64_t mtime; // Nanoseconds
+    uint64_t hash; // FNV-1a of the content
+} MANIFEST_ENTRY;
+
+typedef struct
+{
+    MANIFEST_HEADER header;
+    MANIFEST_ENTRY *entries;
+} MANIFEST;
+
+/* An input that needs to be read, with what the previous run recorded about it (NULL if it's new) */
+typedef struct
+{
+    MANIFEST_ENTRY entry;
+    const MANIFEST_ENTRY *previous;
+} MANIFEST_JOB;
+
+void manifestInit(MANIFEST *m, const CONFIG *config);
+void manifestLoad(MANIFEST *m, const char *file);
+void manifestFree(MANIFEST *m);
+bool manifestWrite(MANIFEST *m, const char *file);
+const MANIFEST_ENTRY *manifestFind(const MANIFEST *m, const char *name);
+bool manifestUpdate(MANIFEST_JOB *job, const uint8_t *blob, size_t size);
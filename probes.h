@@ -0,0 +1,30 @@
+#pragma once
+
+/*
+ * USDT probes for bpftrace/perf, provider diagconv
+ *
+ * Only built with make USDT=1 (needs sys/sdt.h from systemtap), otherwise they compile to nothing. In a USDT build
+ * each probe is a nop plus an ELF note, so the probes can stay in the shipping binary. Strings are null terminated:
+ *  - process__entry(name): A worker starts on NAME.bin
+ *  - process__return(name, size, ret): Done with it, size is -1 if it couldn't be read
+ *  - dispatch(name, type, magic): The parser got picked by the file magic, type is a DIC_TYPE or DIC_TYPES if unknown
+ *  - dict__miss(name, type): No map entry
+ *  - transcode__start(length, utf8) / transcode__done(length, outLength): Around each string conversion
+ *  - output__render(path, size, messages): An output file got rendered and goes to the writer
+ *  - output__open(path, language) / output__close(path, size, ok): Around writing it
+ */
+#ifdef HAVE_USDT
+
+#include <sys/sdt.h>
+
+#define PROBE1(name, a) DTRACE_PROBE1(diagconv, name, a)
+#define PROBE2(name, a, b) DTRACE_PROBE2(diagconv, name, a, b)
+#define PROBE3(name, a, b, c) DTRACE_PROBE3(diagconv, name, a, b, c)
+
+#else
+
+#define PROBE1(name, a) do { (void)(a); } while(0)
+#define PROBE2(name, a, b) do { (void)(a); (void)(b); } while(0)
+#define PROBE3(name, a, b, c) do { (void)(a); (void)(b); (void)(c); } while(0)
+
+#endif
@@ -0,0 +1,139 @@
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ring.h"
+
+/* Backs off a bit more with every failed try: Retry, then yield, then sleep */
+static void ringWait(unsigned int tries)
+{
+    if(tries < 16)
+        return;
+
+    if(tries < 64)
+    {
+        sched_yield();
+        return;
+    }
+
+    struct timespec ts = { .tv_sec = 0, .tv_nsec = 50000 };
+    nanosleep(&ts, NULL);
+}
+
+/* capacity gets rounded up to a power of two, producers is the number of ringDone() calls closing the queue */
+bool ringInit(RING *r, size_t capacity, unsigned int producers)
+{
+    size_t size = 2;
+    while(size < capacity)
+        size *= 2;
+
+    r->cells = malloc(sizeof(RING_CELL) * size);
+    if(r->cells == NULL)
+        return false;
+
+    for(size_t i = 0; i < size; i++)
+        atomic_init(&r->cells[i].seq, i);
+
+    r->mask = size - 1;
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    atomic_init(&r->producers, producers);
+    atomic_init(&r->closed, producers == 0);
+    atomic_init(&r->pushWaits, 0);
+    atomic_init(&r->popWaits, 0);
+    return true;
+}
+
+void ringFree(RING *r)
+{
+    free(r->cells);
+    r->cells = NULL;
+}
+
+/* Returns false if the queue is full */
+bool ringTryPush(RING *r, void *data)
+{
+    size_t pos = atomic_load_explicit(&r->head, memory_order_relaxed);
+    while(true)
+    {
+        RING_CELL *cell = r->cells + (pos & r->mask);
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if(diff == 0)
+        {
+            if(atomic_compare_exchange_weak_explicit(&r->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                cell->data = data;
+                atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if(diff < 0)
+            return false; // Still holds the data of the last lap
+        else
+            pos = atomic_load_explicit(&r->head, memory_order_relaxed);
+    }
+}
+
+/* Returns false if the queue is empty */
+bool ringTryPop(RING *r, void **data)
+{
+    size_t pos = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    while(true)
+    {
+        RING_CELL *cell = r->cells + (pos & r->mask);
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if(diff == 0)
+        {
+            if(atomic_compare_exchange_weak_explicit(&r->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                *data = cell->data;
+                atomic_store_explicit(&cell->seq, pos + r->mask + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if(diff < 0)
+            return false; // Not pushed yet
+        else
+            pos = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    }
+}
+
+/* Pushes, waiting for room as long as it takes */
+void ringPush(RING *r, void *data)
+{
+    if(ringTryPush(r, data))
+        return;
+
+    atomic_fetch_add_explicit(&r->pushWaits, 1, memory_order_relaxed);
+    for(unsigned int tries = 0; !ringTryPush(r, data); tries++)
+        ringWait(tries);
+}
+
+/* Pops, waiting for data as long as there are producers left. Returns false once the queue is closed and empty */
+bool ringPop(RING *r, void **data)
+{
+    if(ringTryPop(r, data))
+        return true;
+
+    atomic_fetch_add_explicit(&r->popWaits, 1, memory_order_relaxed);
+    for(unsigned int tries = 0; ; tries++)
+    {
+        // Everything got pushed before the queue got closed, so one more try after seeing that finds the rest
+        if(atomic_load_explicit(&r->closed, memory_order_acquire))
+            return ringTryPop(r, data);
+
+        if(ringTryPop(r, data))
+            return true;
+
+        ringWait(tries);
+    }
+}
+
+/* Called by each producer once it's done, the last one closes the queue */
+void ringDone(RING *r)
+{
+    if(atomic_fetch_sub_explicit(&r->producers, 1, memory_order_acq_rel) == 1)
+        atomic_store_explicit(&r->closed, true, memory_order_release);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Lock-free bounded queue of pointers, any number of producers and consumers
+ *
+ * Each cell has a sequence number telling whether it's free for the push of a lap or filled for its pop, so push
+ * and pop are a single compare and swap on the head respectively tail. ringPush() waits while the queue is full,
+ * which is what throttles a producer to the speed of its consumers. Once all producers called ringDone() the
+ * consumers get the rest and then false from ringPop().
+ */
+typedef struct
+{
+    atomic_size_t seq;
+    void *data;
+} RING_CELL;
+
+typedef struct
+{
+    RING_CELL *cells;
+    size_t mask;
+    atomic_size_t head __attribute__((aligned(64))); // Next push
+    atomic_size_t tail __attribute__((aligned(64))); // Next pop
+    atomic_uint producers __attribute__((aligned(64)));
+    atomic_bool closed;
+    atomic_uint_fast64_t pushWaits; // How often ringPush() found the queue full
+    atomic_uint_fast64_t popWaits; // How often ringPop() found the queue empty
+} RING;
+
+bool ringInit(RING *r, size_t capacity, unsigned int producers);
+void ringFree(RING *r);
+bool ringTryPush(RING *r, void *data);
+bool ringTryPop(RING *r, void **data);
+void ringPush(RING *r, void *data);
+bool ringPop(RING *r, void **data);
+void ringDone(RING *r);
@@ -0,0 +1,89 @@
+#include <string.h>
+
+#include "convert.h"
+#include "stats.h"
+
+static const char *phaseNames[PHASES] = {"other", "scan", "mkdir", "read", "inflate", "lookup", "parse", "transcode", "write"};
+static const char *stageNames[STAGES] = {"readers", "parsers", "writers"};
+
+/* Starts in PHASE_OTHER, now */
+void statsInit(STATS *s)
+{
+    memset(s, 0, sizeof(STATS));
+    s->mark = statsNow();
+}
+
+/* Counts an input read by a worker, by its type */
+void statsInput(STATS *s, const uint8_t *blob, size_t size)
+{
+    if(s == NULL)
+        return;
+
+    DIC_TYPE type = blobType(blob);
+    if(type == DIC_TYPES)
+    {
+        s->unknown++;
+        return;
+    }
+
+    s->files[type]++;
+    s->bytesIn[type] += size;
+}
+
+/* Books the running phase of src and adds it to dst */
+void statsMerge(STATS *dst, STATS *src)
+{
+    statsEnter(src, PHASE_OTHER);
+    for(int i = 0; i < PHASES; i++)
+        dst->ns[i] += src->ns[i];
+
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        dst->files[i] += src->files[i];
+        dst->bytesIn[i] += src->bytesIn[i];
+        dst->bytesOut[i] += src->bytesOut[i];
+        dst->messages[i] += src->messages[i];
+        dst->unmapped[i] += src->unmapped[i];
+    }
+
+    dst->unknown += src->unknown;
+}
+
+/*
+ * Writes the report as a single line of JSON
+ *
+ * The phase times are summed over all threads, so they can add up to more than the wall time.
+ */
+void statsWrite(const STATS *s, FILE *f, uint64_t wallNs, unsigned int threads, unsigned int convert)
+{
+    fprintf(f, "{\"wallNs\":%llu,\"threads\":%u,\"strings\":\"%s\",\"controlBytes\":\"%s\",\"phasesNs\":{",
+            (unsigned long long)wallNs, threads,
+            convert & TO_UTF ? "utf8" : convert & TO_ISO ? "iso8859-1" : "raw",
+            convert & TO_COM ? "binary" : convert & TO_CON ? "escaped" : "none");
+
+    for(int i = 0; i < PHASES; i++)
+        fprintf(f, "%s\"%s\":%llu", i ? "," : "", phaseNames[i], (unsigned long long)s->ns[i]);
+
+    fprintf(f, "},\"types\":{");
+    for(int i = 0; i < DIC_TYPES; i++)
+    {
+        fprintf(f, "%s\"%s\":{\"files\":%llu,\"bytesIn\":%llu,\"bytesOut\":%llu,\"messages\":%llu,\"unmapped\":%llu}",
+                i ? "," : "", typeDir[i], (unsigned long long)s->files[i], (unsigned long long)s->bytesIn[i],
+                (unsigned long long)s->bytesOut[i], (unsigned long long)s->messages[i], (unsigned long long)s->unmapped[i]);
+    }
+
+    fprintf(f, "},\"unknown\":%llu", (unsigned long long)s->unknown);
+    if(s->stages[STAGE_PARSE] != 0)
+    {
+        fprintf(f, ",\"pipeline\":{");
+        for(int i = 0; i < STAGES; i++)
+        {
+            fprintf(f, "%s\"%s\":{\"threads\":%u,\"starved\":%llu,\"blocked\":%llu}", i ? "," : "", stageNames[i],
+                    s->stages[i], (unsigned long long)s->starved[i], (unsigned long long)s->blocked[i]);
+        }
+
+        fprintf(f, "}");
+    }
+
+    fprintf(f, "}\n");
+}
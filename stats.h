@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "dictionary.h"
+
+/*
+ * Per phase timing and counters for --stats
+ *
+ * Each thread owns a STATS and is always in exactly one phase. statsEnter() switches phases and books the time since
+ * the last switch to the old one, so nested phases (writing from within the parser, transcoding) get exclusive times
+ * with a single clock read per switch. Everything is NULL safe, without --stats the cost is a branch per call.
+ */
+typedef enum
+{
+    PHASE_OTHER = 0, // Not in any phase, for example waiting for a job
+    PHASE_SCAN, // readdir() of the input folder
+    PHASE_MKDIR, // Creating the output tree
+    PHASE_READ, // Reading the inputs
+    PHASE_INFLATE, // Unpacking compressed inputs (--inflate)
+    PHASE_LOOKUP, // Dictionary lookup
+    PHASE_PARSE, // Parsing and rendering, without the lookup and transcoding
+    PHASE_TRANSCODE, // Transcoding of the strings
+    PHASE_WRITE, // Writing the outputs
+    PHASES
+} PHASE;
+
+/* The thread stages of --pipeline */
+typedef enum
+{
+    STAGE_READ = 0,
+    STAGE_PARSE, // Parsing, transcoding and rendering
+    STAGE_WRITE,
+    STAGES
+} STAGE;
+
+typedef struct
+{
+    PHASE phase;
+    uint64_t mark; // When the current phase started
+    uint64_t ns[PHASES];
+    uint64_t files[DIC_TYPES];
+    uint64_t bytesIn[DIC_TYPES];
+    uint64_t bytesOut[DIC_TYPES];
+    uint64_t messages[DIC_TYPES];
+    uint64_t unmapped[DIC_TYPES];
+    uint64_t unknown; // Inputs with an unknown file magic
+    unsigned int stages[STAGES]; // --pipeline: Threads per stage, all 0 without
+    uint64_t starved[STAGES]; // --pipeline: Waits for input from the stage before
+    uint64_t blocked[STAGES]; // --pipeline: Waits for room in the queue to the stage after (backpressure)
+} STATS;
+
+static inline uint64_t statsNow()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Switches to phase, returns the previous one to switch back to */
+static inline PHASE statsEnter(STATS *s, PHASE phase)
+{
+    if(s == NULL)
+        return phase;
+
+    uint64_t now = statsNow();
+    PHASE prev = s->phase;
+    s->ns[prev] += now - s->mark;
+    s->mark = now;
+    s->phase = phase;
+    return prev;
+}
+
+/* Forgets the time since the last switch, for a thread that only waited for others which book their own time */
+static inline void statsSkip(STATS *s)
+{
+    if(s != NULL)
+        s->mark = statsNow();
+}
+
+void statsInit(STATS *s);
+void statsInput(STATS *s, const uint8_t *blob, size_t size);
+void statsMerge(STATS *dst, STATS *src);
+void statsWrite(const STATS *s, FILE *f, uint64_t wallNs, unsigned int threads, unsigned int convert);
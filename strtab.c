@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strtab.h"
+
+struct STRTAB_RECORD
+{
+    uint8_t language;
+    uint8_t type;
+    uint8_t section;
+    uint8_t cmd;
+    uint16_t id;
+    uint16_t index;
+    uint32_t input; // Index of the input file this is from, inputs mapping to the same name may show up twice
+    uint32_t builder;
+    uint32_t offset; // Relative to the builders strings
+    uint32_t length;
+};
+
+typedef struct STRTAB_RECORD STRTAB_RECORD;
+
+void strtabInit(STRTAB_BUILDER *b)
+{
+    memset(b, 0, sizeof(STRTAB_BUILDER));
+    emitterInit(&b->strings);
+}
+
+void strtabFree(STRTAB_BUILDER *b)
+{
+    free(b->records);
+    emitterFree(&b->strings);
+    strtabInit(b);
+}
+
+/* Starts a new file, the messages added after this belong to it */
+void strtabBeginFile(STRTAB_BUILDER *b, int language, DIC_TYPE type, uint16_t id)
+{
+    b->language = language;
+    b->type = type;
+    b->id = id;
+    memset(b->index, 0, sizeof(b->index));
+}
+
+/*
+ * Adds the next message of a section of the current file
+ *
+ * The string gets converted to UTF-8 with charset, NULL means it gets stored as is.
+ */
+bool strtabAdd(STRTAB_BUILDER *b, unsigned int section, uint8_t cmd, const char *prefix, size_t prefixLength,
+               const char *msg, size_t length, const CHARSET *charset)
+{
+    if(b->count == b->capacity)
+    {
+        size_t capacity = b->capacity ? b->capacity * 2 : 4096;
+        STRTAB_RECORD *records = realloc(b->records, capacity * sizeof(STRTAB_RECORD));
+        if(records == NULL)
+        {
+            fprintf(stderr, "Out of memory\n");
+            return false;
+        }
+
+        b->records = records;
+        b->capacity = capacity;
+    }
+
+    size_t needed = prefixLength + (charset ? CHARSET_UTF8_MAX(length) : length);
+    EMITTER *s = &b->strings;
+    if(s->size + needed > s->capacity && !emitterGrow(s, needed))
+        return false;
+
+    STRTAB_RECORD *r = b->records + b->count++;
+    r->language = b->language;
+    r->type = b->type;
+    r->section = section;
+    r->cmd = cmd;
+    r->id = b->id;
+    r->index = b->index[section]++;
+    r->input = b->input;
+    r->offset = s->size;
+
+    memcpy(s->data + s->size, prefix, prefixLength);
+    s->size += prefixLength;
+    if(charset != NULL)
+        s->size += charsetToUtf8(charset, (const uint8_t *)msg, length, (uint8_t *)s->data + s->size, CHARSET_UTF8_MAX(length));
+    else
+    {
+        memcpy(s->data + s->size, msg, length);
+        s->size += length;
+    }
+
+    r->length = s->size - r->offset;
+    return true;
+}
+
+static int compareRecords(const void *a, const void *b)
+{
+    const STRTAB_RECORD *ra = a;
+    const STRTAB_RECORD *rb = b;
+    if(ra->type != rb->type)
+        return ra->type - rb->type;
+    if(ra->id != rb->id)
+        return ra->id - rb->id;
+    if(ra->input != rb->input)
+        return ra->input < rb->input ? -1 : 1;
+    if(ra->section != rb->section)
+        return ra->section - rb->section;
+
+    return ra->index - rb->index;
+}
+
+static uint32_t hashString(const char *s, size_t length)
+{
+    uint32_t h = 0x811C9DC5;
+    for(size_t i = 0; i < length; i++)
+    {
+        h ^= (uint8_t)s[i];
+        h *= 0x01000193;
+    }
+
+    return h;
+}
+
+/* Grows out by size bytes and returns where they go */
+static void *reserve(EMITTER *out, size_t size)
+{
+    if(out->size + size > out->capacity && !emitterGrow(out, size))
+        return NULL;
+
+    void *ret = out->data + out->size;
+    out->size += size;
+    return ret;
+}
+
+/*
+ * Merges the messages of one language from all builders into a string table, see strtab.h for the format
+ *
+ * If several inputs map to the same file name the last one in input order wins, no matter which worker parsed it.
+ * That's the one whose YAML file is left in the output tree, when they get converted one after the other.
+ */
+bool strtabBuild(STRTAB_BUILDER *builders, size_t count, int language, EMITTER *out)
+{
+    size_t n = 0;
+    for(size_t i = 0; i < count; i++)
+        for(size_t j = 0; j < builders[i].count; j++)
+            n += builders[i].records[j].language == language;
+
+    STRTAB_RECORD *records = malloc(sizeof(STRTAB_RECORD) * (n ? n : 1));
+    STRTAB_FILE *files = malloc(sizeof(STRTAB_FILE) * (n ? n : 1));
+    STRTAB_MESSAGE *messages = malloc(sizeof(STRTAB_MESSAGE) * (n ? n : 1));
+    size_t dedupSize = 1;
+    while(dedupSize < n * 2)
+        dedupSize <<= 1;
+
+    uint32_t *dedup = calloc(dedupSize, sizeof(uint32_t)); // Index of the first message with that string + 1
+    EMITTER blob;
+    emitterInit(&blob);
+    bool ret = records != NULL && files != NULL && messages != NULL && dedup != NULL;
+    if(!ret)
+        fprintf(stderr, "Out of memory\n");
+
+    n = 0;
+    for(size_t i = 0; ret && i < count; i++)
+    {
+        for(size_t j = 0; j < builders[i].count; j++)
+        {
+            if(builders[i].records[j].language != language)
+                continue;
+
+            records[n] = builders[i].records[j];
+            records[n++].builder = i;
+        }
+    }
+
+    if(ret)
+        qsort(records, n, sizeof(STRTAB_RECORD), compareRecords);
+
+    uint32_t fileCount = 0, messageCount = 0;
+    for(size_t i = 0; ret && i < n; )
+    {
+        STRTAB_FILE *f = files + fileCount++;
+        memset(f, 0, sizeof(STRTAB_FILE));
+        f->type = records[i].type;
+        f->id = records[i].id;
+
+        // Take the messages of the last input with this name, skip the others
+        size_t end = i;
+        while(end < n && records[end].type == f->type && records[end].id == f->id)
+            end++;
+
+        uint32_t input = records[end - 1].input;
+        for(size_t j = i; ret && j < end; j++)
+        {
+            const STRTAB_RECORD *r = records + j;
+            if(r->input != input)
+                continue;
+
+            if(f->count[r->section]++ == 0)
+                f->first[r->section] = messageCount;
+
+            const char *s = builders[r->builder].strings.data + r->offset;
+            uint32_t slot = hashString(s, r->length) & (dedupSize - 1);
+            for(; dedup[slot] != 0; slot = (slot + 1) & (dedupSize - 1))
+            {
+                const STRTAB_MESSAGE *m = messages + dedup[slot] - 1;
+                if(m->length == r->length && memcmp(blob.data + m->offset, s, r->length) == 0)
+                    break;
+            }
+
+            STRTAB_MESSAGE *m = messages + messageCount;
+            m->length = r->length;
+            m->cmd = r->cmd;
+            m->reserved = 0;
+            if(dedup[slot] != 0)
+                m->offset = messages[dedup[slot] - 1].offset;
+            else
+            {
+                char *dst = reserve(&blob, r->length + 1);
+                if(dst == NULL)
+                {
+                    ret = false;
+                    break;
+                }
+
+                memcpy(dst, s, r->length);
+                dst[r->length] = '\0';
+                m->offset = blob.size - r->length - 1;
+                dedup[slot] = messageCount + 1;
+            }
+
+            messageCount++;
+        }
+
+        i = end;
+    }
+
+    uint32_t slotCount = 1;
+    while(slotCount < fileCount * 2)
+        slotCount <<= 1;
+
+    STRTAB_HEADER hdr = {
+        .magic = STRTAB_MAGIC,
+        .version = STRTAB_VERSION,
+        .language = language,
+        .slotCount = slotCount,
+        .fileCount = fileCount,
+        .messageCount = messageCount,
+        .blobSize = blob.size,
+    };
+
+    hdr.slotsOffset = sizeof(STRTAB_HEADER);
+    hdr.filesOffset = hdr.slotsOffset + slotCount * sizeof(uint32_t);
+    hdr.messagesOffset = hdr.filesOffset + fileCount * sizeof(STRTAB_FILE);
+    hdr.blobOffset = hdr.messagesOffset + messageCount * sizeof(STRTAB_MESSAGE);
+
+    emitterReset(out);
+    uint32_t *slots = ret ? reserve(out, hdr.blobOffset + blob.size) : NULL;
+    if(slots != NULL)
+    {
+        memcpy(out->data, &hdr, sizeof(hdr));
+        slots = (uint32_t *)(out->data + hdr.slotsOffset);
+        memset(slots, 0, slotCount * sizeof(uint32_t));
+        for(uint32_t i = 0; i < fileCount; i++)
+        {
+            uint32_t s = strtabSlot(files[i].type, files[i].id, slotCount);
+            while(slots[s] != 0)
+                s = (s + 1) & (slotCount - 1);
+
+            slots[s] = i + 1;
+        }
+
+        memcpy(out->data + hdr.filesOffset, files, fileCount * sizeof(STRTAB_FILE));
+        memcpy(out->data + hdr.messagesOffset, messages, messageCount * sizeof(STRTAB_MESSAGE));
+        memcpy(out->data + hdr.blobOffset, blob.data, blob.size);
+    }
+    else
+        ret = false;
+
+    emitterFree(&blob);
+    free(dedup);
+    free(messages);
+    free(files);
+    free(records);
+    return ret;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "charset.h"
+#include "dictionary.h"
+#include "emitter.h"
+
+/*
+ * Binary string table, one per language (XX.strtab), written by --strtab
+ *
+ * Meant to be mmapped by the game: Any message can be looked up with strtabFind() without parsing anything.
+ * Layout, all numbers little endian and all offsets relative to the start of the file:
+ *  - STRTAB_HEADER
+ *  - slotCount uint32_t: Hash table over (type, id), each slot is a file index + 1 or 0 if empty. Linear probing, see strtabSlot()
+ *  - fileCount STRTAB_FILE
+ *  - messageCount STRTAB_MESSAGE, the messages of each section of a file in order
+ *  - blobSize bytes of UTF-8 strings, null terminated and deduplicated
+ *
+ * Sections are bottom (0) and top (1) for dialogs, question (0) and options (1) for quizzes.
+ * Answers have the binary control bytes in front of them if the YAML files have control bytes.
+ */
+#define STRTAB_MAGIC "DCST"
+#define STRTAB_VERSION 1
+#define STRTAB_SECTIONS 2
+
+typedef struct __attribute__((__packed__))
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t language;
+    uint32_t slotCount; // Power of two
+    uint32_t fileCount;
+    uint32_t messageCount;
+    uint32_t blobSize;
+    uint32_t slotsOffset;
+    uint32_t filesOffset;
+    uint32_t messagesOffset;
+    uint32_t blobOffset;
+} STRTAB_HEADER;
+
+typedef struct __attribute__((__packed__))
+{
+    uint8_t type; // DIC_TYPE
+    uint8_t reserved;
+    uint16_t id; // Name of the .dialog/.quiz_q/.grunty_q file
+    uint32_t first[STRTAB_SECTIONS]; // Index of the first message of each section
+    uint16_t count[STRTAB_SECTIONS];
+} STRTAB_FILE;
+
+typedef struct __attribute__((__packed__))
+{
+    uint32_t offset; // Relative to the blob
+    uint16_t length; // Without the null terminator
+    uint8_t cmd;
+    uint8_t reserved;
+} STRTAB_MESSAGE;
+
+static inline uint32_t strtabSlot(DIC_TYPE type, uint16_t id, uint32_t slotCount)
+{
+    return (((uint32_t)type << 16 | id) * 0x9E3779B1) & (slotCount - 1);
+}
+
+/* Looks a message up in a mapped string table, returns NULL if there's no such message */
+static inline const STRTAB_MESSAGE *strtabFind(const void *map, DIC_TYPE type, uint16_t id, unsigned int section, uint32_t index)
+{
+    const STRTAB_HEADER *hdr = map;
+    const uint32_t *slots = (const uint32_t *)((const uint8_t *)map + hdr->slotsOffset);
+    const STRTAB_FILE *files = (const STRTAB_FILE *)((const uint8_t *)map + hdr->filesOffset);
+    if(section >= STRTAB_SECTIONS)
+        return NULL;
+
+    for(uint32_t s = strtabSlot(type, id, hdr->slotCount); slots[s] != 0; s = (s + 1) & (hdr->slotCount - 1))
+    {
+        const STRTAB_FILE *f = files + slots[s] - 1;
+        if(f->type == type && f->id == id)
+        {
+            if(index >= f->count[section])
+                return NULL;
+
+            return (const STRTAB_MESSAGE *)((const uint8_t *)map + hdr->messagesOffset) + f->first[section] + index;
+        }
+    }
+
+    return NULL;
+}
+
+/* The string of a message found with strtabFind() */
+static inline const char *strtabString(const void *map, const STRTAB_MESSAGE *msg)
+{
+    return (const char *)map + ((const STRTAB_HEADER *)map)->blobOffset + msg->offset;
+}
+
+/*
+ * Collects the messages while parsing
+ *
+ * Each worker has its own, strtabBuild() merges them at the end.
+ */
+typedef struct
+{
+    struct STRTAB_RECORD *records;
+    size_t count;
+    size_t capacity;
+    EMITTER strings;
+    uint32_t input; // Index of the input file being parsed, see strtabSetInput()
+    uint8_t language;
+    uint8_t type;
+    uint16_t id;
+    uint16_t index[STRTAB_SECTIONS];
+} STRTAB_BUILDER;
+
+/* Tells the builder (if any) which input file the messages added from now on come from */
+static inline void strtabSetInput(STRTAB_BUILDER *b, uint32_t input)
+{
+    if(b != NULL)
+        b->input = input;
+}
+
+void strtabInit(STRTAB_BUILDER *b);
+void strtabFree(STRTAB_BUILDER *b);
+void strtabBeginFile(STRTAB_BUILDER *b, int language, DIC_TYPE type, uint16_t id);
+bool strtabAdd(STRTAB_BUILDER *b, unsigned int section, uint8_t cmd, const char *prefix, size_t prefixLength,
+               const char *msg, size_t length, const CHARSET *charset);
+bool strtabBuild(STRTAB_BUILDER *builders, size_t count, int language, EMITTER *out);
@@ -0,0 +1,242 @@
+/*
+ * Build time generator for charsets.c
+ *
+ * Reads the character set definitions given as arguments (see charsets/rare.charset for the format)
+ * and writes the lookup tables for each of them to stdout. See charset.h for the layout.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "charset.h"
+
+static void fail(const char *file, int line, const char *msg)
+{
+    fprintf(stderr, "%s:%d: %s\n", file, line, msg);
+    exit(1);
+}
+
+/* Parses a hexadecimal byte, the whole token has to be consumed */
+static uint8_t hexByte(const char *file, int line, const char *token)
+{
+    char *end;
+    unsigned long v = token == NULL ? 0x100 : strtoul(token, &end, 16);
+    if(token == NULL || *end != '\0' || end == token || v > 0xFF)
+        fail(file, line, "Expected a hexadecimal number in 00 - FF");
+
+    return v;
+}
+
+static void parse(const char *file, CHARSET *cs, char *name, size_t nameSize)
+{
+    FILE *f = fopen(file, "r");
+    if(f == NULL)
+    {
+        fprintf(stderr, "Error opening %s\n", file);
+        exit(1);
+    }
+
+    bool defined[256] = { false };
+    *name = '\0';
+    for(int c = 0; c < 256; c++)
+    {
+        cs->iso[c] = c;
+        cs->control[c] = CHARSET_TEXT;
+    }
+
+    char buf[256];
+    for(int line = 1; fgets(buf, sizeof(buf), f) != NULL; line++)
+    {
+        char *comment = strchr(buf, '#');
+        if(comment != NULL)
+            *comment = '\0';
+
+        char *token = strtok(buf, " \t\r\n");
+        if(token == NULL)
+            continue;
+
+        if(strcmp(token, "name") == 0)
+        {
+            token = strtok(NULL, " \t\r\n");
+            if(token == NULL || strlen(token) >= nameSize)
+                fail(file, line, "Invalid name");
+
+            strcpy(name, token);
+        }
+        else
+        {
+            uint8_t c;
+            if(strcmp(token, "stop") == 0)
+            {
+                c = hexByte(file, line, strtok(NULL, " \t\r\n"));
+                cs->control[c] = CHARSET_STOP;
+            }
+            else if(strcmp(token, "control") == 0)
+            {
+                c = hexByte(file, line, strtok(NULL, " \t\r\n"));
+                uint8_t args = hexByte(file, line, strtok(NULL, " \t\r\n"));
+                if(args + 1 >= CHARSET_STOP)
+                    fail(file, line, "Too many arguments");
+
+                cs->control[c] = args + 1;
+            }
+            else
+            {
+                c = hexByte(file, line, token);
+                cs->iso[c] = hexByte(file, line, strtok(NULL, " \t\r\n"));
+            }
+
+            if(defined[c])
+                fail(file, line, "Byte defined twice");
+
+            defined[c] = true;
+        }
+
+        if(strtok(NULL, " \t\r\n") != NULL)
+            fail(file, line, "Trailing garbage");
+    }
+
+    fclose(f);
+    if(*name == '\0')
+        fail(file, 0, "No name given");
+
+    // Everything else follows from the ISO-8859-1 values
+    cs->rowCount = 0;
+    memset(cs->controlBits, 0, sizeof(cs->controlBits));
+    for(int c = 0; c < 256; c++)
+    {
+        if(cs->control[c] != CHARSET_TEXT)
+            cs->controlBits[c >> 7][c & 0x0F] |= 1 << ((c >> 4) & 0x07);
+
+        // Unmapped bytes are passed through as is, even in UTF-8 mode
+        if(cs->iso[c] == c || cs->control[c] != CHARSET_TEXT)
+        {
+            cs->utf8[c][0] = c;
+            cs->utf8[c][1] = 0;
+            cs->utf8Length[c] = 1;
+            continue;
+        }
+
+        uint8_t iso = cs->iso[c];
+        if(iso < 0x80)
+        {
+            cs->utf8[c][0] = iso;
+            cs->utf8[c][1] = 0;
+            cs->utf8Length[c] = 1;
+        }
+        else
+        {
+            cs->utf8[c][0] = 0xC0 | (iso >> 6);
+            cs->utf8[c][1] = 0x80 | (iso & 0x3F);
+            cs->utf8Length[c] = 2;
+        }
+
+        uint8_t r = 0;
+        while(r < cs->rowCount && cs->rowNibble[r] != c >> 4)
+            r++;
+
+        if(r == cs->rowCount)
+        {
+            cs->rowNibble[r] = c >> 4;
+            memset(cs->rowDelta[r], 0, 16);
+            memset(cs->rowMapped[r], 0, 16);
+            cs->rowCount++;
+        }
+
+        cs->rowDelta[r][c & 0x0F] = iso - c;
+        cs->rowMapped[r][c & 0x0F] = 0xFF;
+    }
+
+    // Going backwards so the lowest mapped byte wins
+    for(int c = 0; c < 256; c++)
+        cs->fromIso[c] = c;
+
+    for(int c = 255; c >= 0; c--)
+        if(cs->control[c] == CHARSET_TEXT && cs->iso[c] != c)
+            cs->fromIso[cs->iso[c]] = c;
+}
+
+static void writeBytes(const uint8_t *data, size_t size, const char *indent)
+{
+    printf("{");
+    for(size_t i = 0; i < size; i++)
+        printf("%s0x%02X,", i % 16 ? " " : indent, data[i]);
+
+    printf("%.*s}", (int)strlen(indent) - 4, indent);
+}
+
+static void writeCharset(const CHARSET *cs, const char *name)
+{
+    printf("    {\n"
+           "        .name = \"%s\",\n"
+           "        .iso = ", name);
+    writeBytes(cs->iso, 256, "\n            ");
+    printf(",\n        .utf8 = {");
+    for(int c = 0; c < 256; c++)
+        printf("%s{0x%02X, 0x%02X},", c % 8 ? " " : "\n            ", cs->utf8[c][0], cs->utf8[c][1]);
+
+    printf("\n        }");
+    printf(",\n        .utf8Length = ");
+    writeBytes(cs->utf8Length, 256, "\n            ");
+    printf(",\n        .control = ");
+    writeBytes(cs->control, 256, "\n            ");
+    printf(",\n        .fromIso = ");
+    writeBytes(cs->fromIso, 256, "\n            ");
+    printf(",\n        .rowCount = %u,\n        .rowNibble = ", cs->rowCount);
+    writeBytes(cs->rowNibble, cs->rowCount, "\n            ");
+    printf(",\n        .rowDelta = {");
+    for(uint8_t r = 0; r < cs->rowCount; r++)
+    {
+        printf("\n            ");
+        writeBytes(cs->rowDelta[r], 16, "\n                ");
+        printf(",");
+    }
+
+    printf("\n        },\n        .rowMapped = {");
+    for(uint8_t r = 0; r < cs->rowCount; r++)
+    {
+        printf("\n            ");
+        writeBytes(cs->rowMapped[r], 16, "\n                ");
+        printf(",");
+    }
+
+    printf("\n        },\n        .controlBits = {");
+    for(int h = 0; h < 2; h++)
+    {
+        printf("\n            ");
+        writeBytes(cs->controlBits[h], 16, "\n                ");
+        printf(",");
+    }
+
+    printf("\n        },\n    },\n");
+}
+
+int main(int argc, char *argv[])
+{
+    printf("/* Generated by tools/genCharset.c - do not edit */\n\n"
+           "#include \"charset.h\"\n\n"
+           "const CHARSET charsets[] = {\n");
+
+    static char names[256][64];
+    if(argc - 1 > 256)
+    {
+        fprintf(stderr, "Too many character sets\n");
+        return 1;
+    }
+
+    for(int i = 1; i < argc; i++)
+    {
+        CHARSET cs;
+        parse(argv[i], &cs, names[i - 1], sizeof(names[i - 1]));
+        for(int j = 0; j < i - 1; j++)
+            if(strcmp(names[j], names[i - 1]) == 0)
+                fail(argv[i], 0, "Name already used");
+
+        writeCharset(&cs, names[i - 1]);
+    }
+
+    printf("};\n\nconst size_t charsetCount = %d;\n", argc - 1);
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * Build time generator for dicHash.c
+ *
+ * Gets linked against dialogDic.c and quizDic.c and writes a minimal perfect hash for each of their tables to stdout.
+ * See dicHash.h for the layout and the hash functions.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dialogDic.h"
+#include "dicHash.h"
+#include "quizDic.h"
+
+static uint32_t hexValue(const char *in, size_t len)
+{
+    uint32_t ret = 0;
+    for(size_t i = 0; i < len; i++)
+    {
+        char c = in[i];
+        if(c >= '0' && c <= '9')
+            c -= '0';
+        else if(c >= 'A' && c <= 'F')
+            c -= 'A' - 10;
+        else
+        {
+            fprintf(stderr, "Invalid hex string %.*s\n", (int)len, in);
+            exit(1);
+        }
+
+        ret = (ret << 4) | c;
+    }
+
+    return ret;
+}
+
+/* Tries to find displacements for the given bucket count. Returns false if a bucket can't be placed */
+static bool generate(DIC_HASH *hash, const uint32_t *keys, uint16_t *displace, int32_t *slots)
+{
+    uint32_t *bucketOf = malloc(sizeof(uint32_t) * hash->size);
+    uint32_t *sizes = calloc(hash->buckets, sizeof(uint32_t));
+    uint32_t *tmp = malloc(sizeof(uint32_t) * hash->size);
+    bool ret = true;
+
+    for(uint32_t i = 0; i < hash->size; i++)
+    {
+        bucketOf[i] = dicBucket(hash, keys[i]);
+        sizes[bucketOf[i]]++;
+        slots[i] = -1;
+    }
+
+    uint32_t biggest = 0;
+    for(uint32_t i = 0; i < hash->buckets; i++)
+    {
+        displace[i] = 0;
+        if(sizes[i] > biggest)
+            biggest = sizes[i];
+    }
+
+    int32_t *owner = malloc(sizeof(int32_t) * hash->size);
+    for(uint32_t i = 0; i < hash->size; i++)
+        owner[i] = -1;
+
+    // Place the biggest buckets first
+    for(uint32_t b = 0; ret && b < hash->buckets * biggest; b++)
+    {
+        uint32_t bucket = b % hash->buckets;
+        if(sizes[bucket] != biggest - b / hash->buckets)
+            continue;
+
+        uint32_t d = 0;
+        for(; d <= UINT16_MAX; d++)
+        {
+            uint32_t placed = 0;
+            for(uint32_t i = 0; i < hash->size; i++)
+            {
+                if(bucketOf[i] != bucket)
+                    continue;
+
+                uint32_t s = dicSlot(hash, keys[i], d);
+                if(owner[s] != -1)
+                    break;
+
+                bool dup = false;
+                for(uint32_t j = 0; j < placed; j++)
+                    if(tmp[j] == s)
+                        dup = true;
+
+                if(dup)
+                    break;
+
+                tmp[placed++] = s;
+            }
+
+            if(placed == sizes[bucket])
+                break;
+        }
+
+        if(d > UINT16_MAX)
+        {
+            ret = false;
+            continue;
+        }
+
+        displace[bucket] = d;
+        for(uint32_t i = 0; i < hash->size; i++)
+        {
+            if(bucketOf[i] == bucket)
+            {
+                uint32_t s = dicSlot(hash, keys[i], d);
+                owner[s] = i;
+                slots[i] = s;
+            }
+        }
+    }
+
+    free(owner);
+    free(tmp);
+    free(sizes);
+    free(bucketOf);
+    return ret;
+}
+
+static void writeHash(const char *name, const char (*in)[6], const char (*out)[4], uint32_t size)
+{
+    uint32_t *keys = malloc(sizeof(uint32_t) * size);
+    int32_t *slots = malloc(sizeof(int32_t) * size);
+    for(uint32_t i = 0; i < size; i++)
+        keys[i] = hexValue(in[i], 6);
+
+    DIC_HASH hash = { .size = size };
+    uint16_t *displace = NULL;
+    for(hash.buckets = (size + 3) / 4; ; hash.buckets++)
+    {
+        displace = realloc(displace, sizeof(uint16_t) * hash.buckets);
+        if(generate(&hash, keys, displace, slots))
+            break;
+    }
+
+    uint8_t (*entries)[5] = calloc(size, 5);
+    for(uint32_t i = 0; i < size; i++)
+    {
+        uint32_t v = hexValue(out[i], 4);
+        entries[slots[i]][0] = keys[i];
+        entries[slots[i]][1] = keys[i] >> 8;
+        entries[slots[i]][2] = keys[i] >> 16;
+        entries[slots[i]][3] = v;
+        entries[slots[i]][4] = v >> 8;
+    }
+
+    printf("\nstatic const uint16_t %sDisplace[%u] = {", name, hash.buckets);
+    for(uint32_t i = 0; i < hash.buckets; i++)
+        printf("%s%u,", i % 16 ? " " : "\n    ", displace[i]);
+
+    printf("\n};\n\nstatic const uint8_t %sEntries[%u][5] = {", name, size);
+    for(uint32_t i = 0; i < size; i++)
+        printf("%s{0x%02X, 0x%02X, 0x%02X, 0x%02X, 0x%02X},", i % 4 ? " " : "\n    ",
+               entries[i][0], entries[i][1], entries[i][2], entries[i][3], entries[i][4]);
+
+    printf("\n};\n\nconst DIC_HASH %sHash = {\n"
+           "    .displace = %sDisplace,\n"
+           "    .entries = %sEntries,\n"
+           "    .buckets = %u,\n"
+           "    .size = %u,\n"
+           "};\n", name, name, name, hash.buckets, size);
+
+    free(entries);
+    free(displace);
+    free(slots);
+    free(keys);
+}
+
+int main()
+{
+    printf("/* Generated by tools/genDicHash.c - do not edit */\n\n"
+           "#include \"dicHash.h\"\n");
+
+    writeHash("diag", diagInList, diagOutList, DIAG_LIST_MAX);
+    writeHash("quiz", quizInList, quizOutList, QUIZ_LIST_MAX);
+    writeHash("grunty", gruntyInList, gruntyOutList, GRUNTY_LIST_MAX);
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "convert.h"
+#include "stats.h"
+#include "trace.h"
+
+void traceInit(TRACE *t)
+{
+    memset(t, 0, sizeof(TRACE));
+}
+
+void traceFree(TRACE *t)
+{
+    free(t->events);
+    traceInit(t);
+}
+
+/* Slow path of traceBegin(), returns TRACE_NONE if there's no memory left for the event */
+size_t traceStart(TRACE *t, const char *name, int language, const char *arg)
+{
+    if(t->count == t->capacity)
+    {
+        size_t capacity = t->capacity ? t->capacity * 2 : 4096;
+        TRACE_EVENT *events = realloc(t->events, capacity * sizeof(TRACE_EVENT));
+        if(events == NULL)
+        {
+            t->dropped++;
+            return TRACE_NONE;
+        }
+
+        t->events = events;
+        t->capacity = capacity;
+    }
+
+    TRACE_EVENT *e = t->events + t->count;
+    e->name = name;
+    e->language = language;
+    if(arg == NULL)
+        e->arg[0] = '\0';
+    else
+    {
+        strncpy(e->arg, arg, sizeof(e->arg) - 1);
+        e->arg[sizeof(e->arg) - 1] = '\0';
+    }
+
+    e->start = e->end = statsNow();
+    return t->count++;
+}
+
+void traceStop(TRACE *t, size_t span)
+{
+    t->events[span].end = statsNow();
+}
+
+/* Opens the output and takes the time all timestamps are relative to */
+bool traceOpen(TRACE_FILE *tf, const char *path)
+{
+    tf->f = fopen(path, "w");
+    if(tf->f == NULL)
+    {
+        fprintf(stderr, "Error opening %s\n", path);
+        return false;
+    }
+
+    tf->origin = statsNow();
+    tf->first = true;
+    fprintf(tf->f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    return true;
+}
+
+/* Writes the spans of a thread as complete ("X") events, the timestamps in µs */
+void traceAppend(TRACE_FILE *tf, const TRACE *t, unsigned int tid, const char *threadName)
+{
+    fprintf(tf->f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            tf->first ? "" : ",\n", tid, threadName);
+    tf->first = false;
+
+    for(size_t i = 0; i < t->count; i++)
+    {
+        const TRACE_EVENT *e = t->events + i;
+        fprintf(tf->f, ",\n{\"name\":\"%s%s%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                e->name, e->language < 0 ? "" : " ", e->language < 0 ? "" : lang[e->language], tid,
+                (e->start - tf->origin) / 1e3, (e->end - e->start) / 1e3);
+
+        // The args are file names and paths, nothing in there needs escaping
+        if(e->arg[0] != '\0')
+            fprintf(tf->f, ",\"args\":{\"file\":\"%s\"}", e->arg);
+
+        fprintf(tf->f, "}");
+    }
+
+    if(t->dropped)
+        fprintf(stderr, "Trace of %s incomplete, %zu spans dropped\n", threadName, t->dropped);
+}
+
+bool traceClose(TRACE_FILE *tf)
+{
+    fprintf(tf->f, "\n]}\n");
+    bool ret = !ferror(tf->f);
+    if(fclose(tf->f) != 0)
+        ret = false;
+
+    if(!ret)
+        fprintf(stderr, "Error writing the trace\n");
+
+    return ret;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Per thread timelines for --trace, written in the Chrome trace-event format (chrome://tracing, Perfetto)
+ *
+ * Each thread records its spans into its own TRACE without any locking, main writes them all out at the end.
+ * Spans nest: traceBegin() returns a handle which traceEnd() closes, so a file span can hold its read, parse and
+ * write spans. Everything is NULL safe, without --trace the cost is a branch per call.
+ */
+#define TRACE_NONE SIZE_MAX
+
+typedef struct
+{
+    const char *name;
+    int language; // -1 if the span isn't for a language
+    char arg[sizeof("XX/grunty_q/XXXX.grunty_q")]; // File name or path, may be empty
+    uint64_t start;
+    uint64_t end;
+} TRACE_EVENT;
+
+typedef struct
+{
+    TRACE_EVENT *events;
+    size_t count;
+    size_t capacity;
+    size_t dropped; // Out of memory
+} TRACE;
+
+/* Where the TRACEs of all threads go */
+typedef struct
+{
+    FILE *f;
+    uint64_t origin; // Timestamps are relative to this
+    bool first;
+} TRACE_FILE;
+
+size_t traceStart(TRACE *t, const char *name, int language, const char *arg);
+void traceStop(TRACE *t, size_t span);
+
+/* Starts a span, arg (file name or path) may be NULL */
+static inline size_t traceBegin(TRACE *t, const char *name, int language, const char *arg)
+{
+    return t == NULL ? TRACE_NONE : traceStart(t, name, language, arg);
+}
+
+static inline void traceEnd(TRACE *t, size_t span)
+{
+    if(t != NULL && span != TRACE_NONE)
+        traceStop(t, span);
+}
+
+void traceInit(TRACE *t);
+void traceFree(TRACE *t);
+bool traceOpen(TRACE_FILE *tf, const char *path);
+void traceAppend(TRACE_FILE *tf, const TRACE *t, unsigned int tid, const char *threadName);
+bool traceClose(TRACE_FILE *tf);
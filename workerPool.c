@@ -0,0 +1,180 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "workerPool.h"
+
+/*
+ * The jobs are indices, so each workers deque is a simple range [head, tail).
+ * The owner pops from the tail, thieves steal the upper half from the head.
+ */
+typedef struct
+{
+    pthread_mutex_t lock;
+    size_t head;
+    size_t tail;
+} DEQUE;
+
+typedef struct
+{
+    DEQUE *deques;
+    unsigned int threads;
+    POOL_JOB fn;
+    atomic_int ret;
+} POOL;
+
+typedef struct
+{
+    POOL *pool;
+    unsigned int id;
+    void *ctx;
+    pthread_t thread;
+} WORKER;
+
+/* Takes a job from the own deque */
+static bool popJob(DEQUE *dq, size_t *job)
+{
+    bool ret = false;
+    pthread_mutex_lock(&dq->lock);
+    if(dq->head < dq->tail)
+    {
+        *job = --dq->tail;
+        ret = true;
+    }
+
+    pthread_mutex_unlock(&dq->lock);
+    return ret;
+}
+
+/*
+ * Steals half of the jobs of another workers deque
+ *
+ * The first stolen job is returned in job, the rest gets moved into the own deque.
+ */
+static bool stealJobs(POOL *pool, unsigned int id, size_t *job)
+{
+    for(unsigned int i = 1; i < pool->threads; i++)
+    {
+        DEQUE *victim = pool->deques + ((id + i) % pool->threads);
+        size_t head, tail;
+
+        pthread_mutex_lock(&victim->lock);
+        size_t left = victim->tail - victim->head;
+        if(left == 0)
+        {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+
+        head = victim->head;
+        tail = head + (left + 1) / 2;
+        victim->head = tail;
+        pthread_mutex_unlock(&victim->lock);
+
+        *job = head++;
+        DEQUE *own = pool->deques + id;
+        pthread_mutex_lock(&own->lock);
+        own->head = head;
+        own->tail = tail;
+        pthread_mutex_unlock(&own->lock);
+        return true;
+    }
+
+    return false;
+}
+
+static void *workerMain(void *arg)
+{
+    WORKER *w = arg;
+    POOL *pool = w->pool;
+    size_t job;
+
+    while(atomic_load_explicit(&pool->ret, memory_order_relaxed) == 0)
+    {
+        if(!popJob(pool->deques + w->id, &job) && !stealJobs(pool, w->id, &job))
+            break;
+
+        int r = pool->fn(w->ctx, job);
+        if(r != 0)
+        {
+            int expected = 0;
+            atomic_compare_exchange_strong(&pool->ret, &expected, r);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Runs the jobs 0 to jobs - 1 on a pool of worker threads
+ *
+ * ctx points to an array of threads per-worker contexts, each ctxSize bytes big.
+ * The jobs get distributed evenly at start, idle workers steal from busy ones.
+ * With threads <= 1 everything runs in order on the calling thread.
+ */
+int poolRun(size_t jobs, unsigned int threads, POOL_JOB fn, void *ctx, size_t ctxSize)
+{
+    if(threads <= 1)
+    {
+        for(size_t i = 0; i < jobs; i++)
+        {
+            int ret = fn(ctx, i);
+            if(ret != 0)
+                return ret;
+        }
+
+        return 0;
+    }
+
+    POOL pool = {
+        .deques = malloc(sizeof(DEQUE) * threads),
+        .threads = threads,
+        .fn = fn,
+    };
+    WORKER *workers = malloc(sizeof(WORKER) * threads);
+    if(pool.deques == NULL || workers == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        free(pool.deques);
+        free(workers);
+        return 1;
+    }
+
+    atomic_init(&pool.ret, 0);
+    for(unsigned int i = 0; i < threads; i++)
+    {
+        pthread_mutex_init(&pool.deques[i].lock, NULL);
+        pool.deques[i].head = jobs * i / threads;
+        pool.deques[i].tail = jobs * (i + 1) / threads;
+        workers[i].pool = &pool;
+        workers[i].id = i;
+        workers[i].ctx = (uint8_t *)ctx + ctxSize * i;
+    }
+
+    // Worker 0 runs on the calling thread
+    unsigned int started = 1;
+    for(; started < threads; started++)
+    {
+        if(pthread_create(&workers[started].thread, NULL, workerMain, workers + started) != 0)
+        {
+            fprintf(stderr, "Error creating worker thread\n");
+            break;
+        }
+    }
+
+    // Deques of threads we couldn't start get emptied by the others
+    workerMain(workers);
+
+    for(unsigned int i = 1; i < started; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    for(unsigned int i = 0; i < threads; i++)
+        pthread_mutex_destroy(&pool.deques[i].lock);
+
+    free(workers);
+    free(pool.deques);
+    return atomic_load(&pool.ret);
+}
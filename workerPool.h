@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stddef.h>
+
+/*
+ * A job callback
+ *
+ * ctx is the per-worker context handed to poolRun(), job the index of the job to process.
+ * A return value != 0 stops the pool: No new jobs will be started and poolRun() will return that value.
+ */
+typedef int (*POOL_JOB)(void *ctx, size_t job);
+
+int poolRun(size_t jobs, unsigned int threads, POOL_JOB fn, void *ctx, size_t ctxSize);